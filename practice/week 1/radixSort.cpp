@@ -1,41 +1,164 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <cstdlib>
+#include <type_traits>
+#include "parallel.h"
 using namespace std;
 
-void countingSortByDigit(vector<int>& arr, int n, int exp) {
-    vector<int> output(n);
-    vector<int> count(10, 0);
+// LSD radix sort on 8-bit digits for 32/64-bit signed and unsigned keys,
+// optionally carrying a value per key.
+//
+// - keys are mapped to unsigned bits with the sign bit flipped, so negative
+//   numbers come first
+// - the histograms of every digit are built in a single scan
+// - a pass where all keys share the same digit is skipped
+// - passes move between the input and one scratch buffer; if the last pass
+//   ends in the scratch, it is copied back once
+// - with several threads each one counts and scatters its own slice, writing
+//   through per-thread offsets, which keeps the sort stable
 
-    // Count occurrences of each digit at current place
-    for (int i = 0; i < n; i++) {
-        int digit = (arr[i] / exp) % 10;
-        count[digit]++;
+const int RADIX_BITS = 8;
+const int RADIX_BUCKETS = 1 << RADIX_BITS;
+const long RADIX_MIN_SLICE = 1 << 16;
+
+template <class K>
+typename make_unsigned<K>::type radixBits(K key) {
+    typedef typename make_unsigned<K>::type U;
+    U bits = (U)key;
+    if (is_signed<K>::value) bits ^= (U)1 << (sizeof(K) * 8 - 1);
+    return bits;
+}
+
+template <class K>
+int radixDigit(K key, int pass) {
+    return (radixBits(key) >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1);
+}
+
+// counts[pass * RADIX_BUCKETS + digit] for every pass, in one scan
+template <class K>
+void radixHistogram(const K* keys, long begin, long end, long* counts) {
+    const int passes = sizeof(K);
+    for (long i = begin; i < end; i++) {
+        typename make_unsigned<K>::type bits = radixBits(keys[i]);
+        for (int p = 0; p < passes; p++) {
+            counts[p * RADIX_BUCKETS + ((bits >> (p * RADIX_BITS)) & (RADIX_BUCKETS - 1))]++;
+        }
     }
+}
+
+template <class K, class V, bool WithValues>
+void radixSortCore(K* keys, V* values, long n, long threads) {
+    if (n < 2) return;
+    const int passes = sizeof(K);
+    threads = max(1L, min(threads, n / RADIX_MIN_SLICE));
+
+    vector<K> keyScratch(n);
+    vector<V> valueScratch(WithValues ? n : 0);
+
+    // Per-thread histograms of all passes; summed they give the totals used
+    // to spot trivial passes
+    vector<long> counts(threads * passes * RADIX_BUCKETS, 0);
+    parallelFor(threads, n, [&](long t, long begin, long end) {
+        radixHistogram(keys, begin, end, &counts[t * passes * RADIX_BUCKETS]);
+    });
+
+    K* src = keys;
+    K* dst = keyScratch.data();
+    V* valueSrc = values;
+    V* valueDst = valueScratch.data();
+    vector<long> offsets(threads * RADIX_BUCKETS);
+    bool moved = false;
+
+    for (int p = 0; p < passes; p++) {
+        long total[RADIX_BUCKETS] = {0};
+        for (long t = 0; t < threads; t++) {
+            const long* c = &counts[(t * passes + p) * RADIX_BUCKETS];
+            for (int d = 0; d < RADIX_BUCKETS; d++) total[d] += c[d];
+        }
+        if (*max_element(total, total + RADIX_BUCKETS) == n) continue;
+
+        // The per-thread counts were taken on the input; once a pass has
+        // moved keys, each slice has to be counted again for this digit
+        if (moved && threads > 1) {
+            parallelFor(threads, n, [&](long t, long begin, long end) {
+                long* c = &counts[(t * passes + p) * RADIX_BUCKETS];
+                fill(c, c + RADIX_BUCKETS, 0);
+                for (long i = begin; i < end; i++) c[radixDigit(src[i], p)]++;
+            });
+        }
+
+        // Digit-major, thread-minor prefix sums
+        long sum = 0;
+        for (int d = 0; d < RADIX_BUCKETS; d++) {
+            for (long t = 0; t < threads; t++) {
+                offsets[t * RADIX_BUCKETS + d] = sum;
+                sum += counts[(t * passes + p) * RADIX_BUCKETS + d];
+            }
+        }
 
-    // Convert count to prefix sum (cumulative count)
-    for (int i = 1; i < 10; i++)
-        count[i] += count[i - 1];
+        parallelFor(threads, n, [&](long t, long begin, long end) {
+            long* next = &offsets[t * RADIX_BUCKETS];
+            for (long i = begin; i < end; i++) {
+                long to = next[radixDigit(src[i], p)]++;
+                dst[to] = src[i];
+                if (WithValues) valueDst[to] = valueSrc[i];
+            }
+        });
 
-    // Build output array (stable sorting by current digit)
-    for (int i = n - 1; i >= 0; i--) {
-        int digit = (arr[i] / exp) % 10;
-        output[count[digit] - 1] = arr[i];
-        count[digit]--;
+        swap(src, dst);
+        swap(valueSrc, valueDst);
+        moved = true;
     }
 
-    // Copy back to original array
-    for (int i = 0; i < n; i++)
-        arr[i] = output[i];
+    if (src != keys) {
+        parallelFor(threads, n, [&](long, long begin, long end) {
+            copy(src + begin, src + end, keys + begin);
+            if (WithValues) copy(valueSrc + begin, valueSrc + end, values + begin);
+        });
+    }
 }
 
-void radixSort(vector<int>& arr, int n) {
-    if (n == 0) return;
+template <class K>
+void parallelRadixSort(vector<K>& keys, long threads) {
+    static_assert(is_integral<K>::value && (sizeof(K) == 4 || sizeof(K) == 8), "32 or 64-bit integer keys");
+    radixSortCore<K, char, false>(keys.data(), nullptr, keys.size(), threads);
+}
 
-    int maxVal = *max_element(arr.begin(), arr.end());
+template <class K>
+void radixSort(vector<K>& keys) {
+    parallelRadixSort(keys, 1);
+}
 
-    // Apply counting sort for each digit (exp = 1, 10, 100, ...)
-    for (int exp = 1; maxVal / exp > 0; exp *= 10) {
-        countingSortByDigit(arr, n, exp);
+// Sorts keys and applies the same permutation to values
+template <class K, class V>
+void parallelRadixSortPairs(vector<K>& keys, vector<V>& values, long threads) {
+    static_assert(is_integral<K>::value && (sizeof(K) == 4 || sizeof(K) == 8), "32 or 64-bit integer keys");
+    radixSortCore<K, V, true>(keys.data(), values.data(), keys.size(), threads);
+}
+
+template <class K, class V>
+void radixSortPairs(vector<K>& keys, vector<V>& values) {
+    parallelRadixSortPairs(keys, values, 1);
+}
+
+void radixSort(vector<int>& arr, int n) {
+    radixSortCore<int, char, false>(arr.data(), nullptr, n, 1);
+}
+
+int main(int argc, char* argv[]){
+    long threads = (argc == 2) ? atol(argv[1]) : 1;
+    int n;
+    cout << "Enter n:" << endl;
+    cin >> n;
+    vector<int> arr(n);
+    cout << "Enter array elements: ";
+    for(int i= 0; i<n;i++){
+        cin >> arr[i];
+    }
+    parallelRadixSort(arr, threads);
+    for(int num: arr){
+        cout << num << " ";
     }
+
 }
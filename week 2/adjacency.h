@@ -0,0 +1,118 @@
+#ifndef ADJACENCY_H
+#define ADJACENCY_H
+
+#include <vector>
+#include <utility>
+#include "edgelist.h"
+using namespace std;
+
+template <class T>
+struct SpanRange {
+    const T* first;
+    const T* last;
+
+    const T* begin() const { return first; }
+    const T* end() const { return last; }
+    size_t size() const { return last - first; }
+    const T& operator[](size_t i) const { return first[i]; }
+};
+
+// Weighted adjacency in one block (CSR): the (neighbour, weight) pairs of u are
+// edges[offsets[u] .. offsets[u + 1]). Neighbours keep the order in which a
+// push_back-per-edge list would have received them, so traversals visit
+// vertices in the same order as with vector<list<pair<int, int>>>.
+template <class W>
+class WeightedAdjacency {
+public:
+    typedef W Weight;
+    static const bool weighted = true;
+
+    WeightedAdjacency() {}
+
+    // Every input edge gives u -> v, and also v -> u when bothWays is set
+    WeightedAdjacency(int n, const vector<InputEdge> &input, bool bothWays) {
+        offsets.assign(n + 1, 0);
+        for (const InputEdge &e : input) {
+            offsets[e.u + 1]++;
+            if (bothWays) offsets[e.v + 1]++;
+        }
+        for (int u = 0; u < n; u++) {
+            offsets[u + 1] += offsets[u];
+        }
+
+        edges.resize(offsets[n]);
+        vector<long> cursor(offsets.begin(), offsets.end() - 1);
+        for (const InputEdge &e : input) {
+            edges[cursor[e.u]++] = {e.v, (W)e.w};
+            if (bothWays) edges[cursor[e.v]++] = {e.u, (W)e.w};
+        }
+    }
+
+    SpanRange<pair<int, W>> operator[](int u) const {
+        return {edges.data() + offsets[u], edges.data() + offsets[u + 1]};
+    }
+
+    int size() const { return offsets.empty() ? 0 : (int)offsets.size() - 1; }
+
+private:
+    vector<long> offsets;
+    vector<pair<int, W>> edges;
+};
+
+typedef WeightedAdjacency<int> FlatAdjacency;
+
+// Unweighted counterpart of WeightedAdjacency, replacing vector<vector<int>>
+class FlatNeighbours {
+public:
+    typedef int Weight;
+    static const bool weighted = false;
+
+    FlatNeighbours() {}
+
+    FlatNeighbours(int n, const vector<InputEdge> &input, bool bothWays) {
+        offsets.assign(n + 1, 0);
+        for (const InputEdge &e : input) {
+            offsets[e.u + 1]++;
+            if (bothWays) offsets[e.v + 1]++;
+        }
+        for (int u = 0; u < n; u++) {
+            offsets[u + 1] += offsets[u];
+        }
+
+        targets.resize(offsets[n]);
+        vector<long> cursor(offsets.begin(), offsets.end() - 1);
+        for (const InputEdge &e : input) {
+            targets[cursor[e.u]++] = e.v;
+            if (bothWays) targets[cursor[e.v]++] = e.u;
+        }
+    }
+
+    SpanRange<int> operator[](int u) const {
+        return {targets.data() + offsets[u], targets.data() + offsets[u + 1]};
+    }
+
+    int size() const { return offsets.empty() ? 0 : (int)offsets.size() - 1; }
+
+private:
+    vector<long> offsets;
+    vector<int> targets;
+};
+
+// The raw weighted edge list, for algorithms such as Kruskal that work on
+// edges rather than neighbourhoods
+class EdgeArray {
+public:
+    typedef int Weight;
+    static const bool weighted = true;
+
+    EdgeArray() : n(0) {}
+
+    EdgeArray(int nodes, vector<InputEdge> input, bool) : n(nodes), edges(move(input)) {}
+
+    int size() const { return n; }
+
+    int n;
+    vector<InputEdge> edges;
+};
+
+#endif // ADJACENCY_H
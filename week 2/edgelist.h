@@ -0,0 +1,246 @@
+#ifndef EDGELIST_H
+#define EDGELIST_H
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+using namespace std;
+
+// Edge list input: a header of whitespace separated tokens, then one edge per
+// line as "u v" or "u v w". Anything after the last number a line needs is
+// ignored, so weighted files can be read as unweighted ones.
+//
+// The file is mmap'd (or read in one go when it cannot be mapped, e.g. a pipe),
+// the edge section is cut into per-thread chunks on newline boundaries and
+// every chunk is parsed with a plain digit loop. Build with -pthread.
+
+struct InputEdge {
+    int u, v, w;
+};
+
+// One thread's share of the edge section: whole lines in [begin, end). The
+// first pass counts lines, the second parses them into out[0 .. parsed).
+struct ParseChunk {
+    const char* begin;
+    const char* end;
+    bool weighted;
+    bool counting;
+    size_t lines;
+    InputEdge* out;
+    size_t parsed;
+};
+
+const size_t PARSE_MIN_CHUNK = 1 << 20; // smaller chunks are not worth a thread
+
+inline const char* parseInt(const char* p, const char* end, int& value) {
+    bool negative = false;
+    if (p < end && *p == '-') {
+        negative = true;
+        ++p;
+    }
+    int x = 0;
+    while (p < end && (unsigned)(*p - '0') < 10) {
+        x = x * 10 + (*p - '0');
+        ++p;
+    }
+    value = negative ? -x : x;
+    return p;
+}
+
+inline void countLines(ParseChunk& chunk) {
+    size_t lines = 0;
+    const char* p = chunk.begin;
+    while (p < chunk.end) {
+        const char* nl = (const char*)memchr(p, '\n', chunk.end - p);
+        ++lines;
+        if (!nl) break;
+        p = nl + 1;
+    }
+    chunk.lines = lines;
+}
+
+inline void parseLines(ParseChunk& chunk) {
+    const char* p = chunk.begin;
+    const char* end = chunk.end;
+    int need = chunk.weighted ? 3 : 2;
+    size_t parsed = 0;
+
+    while (p < end) {
+        int values[3] = {0, 0, 1};
+        int found = 0;
+        while (p < end && *p != '\n') {
+            if (found < need && ((unsigned)(*p - '0') < 10 || *p == '-')) {
+                p = parseInt(p, end, values[found]);
+                ++found;
+            } else {
+                ++p;
+            }
+        }
+        ++p;
+        if (found >= 2) {
+            chunk.out[parsed++] = {values[0], values[1], values[2]};
+        }
+    }
+    chunk.parsed = parsed;
+}
+
+inline void* parseThread(void* arg) {
+    ParseChunk& chunk = *(ParseChunk*)arg;
+    if (chunk.counting) {
+        countLines(chunk);
+    } else {
+        parseLines(chunk);
+    }
+    return nullptr;
+}
+
+// Runs one pass over all chunks, chunk 0 on the calling thread
+inline void runParsePass(vector<ParseChunk>& chunks, bool counting) {
+    vector<pthread_t> workers(chunks.size());
+    for (ParseChunk& c : chunks) c.counting = counting;
+    for (size_t i = 1; i < chunks.size(); ++i) {
+        pthread_create(&workers[i], nullptr, parseThread, &chunks[i]);
+    }
+    parseThread(&chunks[0]);
+    for (size_t i = 1; i < chunks.size(); ++i) {
+        pthread_join(workers[i], nullptr);
+    }
+}
+
+class InputFile {
+public:
+    explicit InputFile(const char* path) : data(nullptr), size(0), pos(0), mapped(false) {
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                madvise(p, st.st_size, MADV_SEQUENTIAL);
+                data = (const char*)p;
+                size = st.st_size;
+                mapped = true;
+            }
+        }
+        if (!mapped) {
+            char block[1 << 16];
+            ssize_t got;
+            while ((got = read(fd, block, sizeof(block))) > 0) {
+                buffer.insert(buffer.end(), block, block + got);
+            }
+            data = buffer.data();
+            size = buffer.size();
+        }
+        close(fd);
+    }
+
+    ~InputFile() {
+        if (mapped) munmap((void*)data, size);
+    }
+
+    InputFile(const InputFile&) = delete;
+    InputFile& operator=(const InputFile&) = delete;
+
+    bool ok() const { return data != nullptr; }
+
+    // Next whitespace separated token of the header
+    bool readWord(string& word) {
+        skipSpace();
+        size_t start = pos;
+        while (pos < size && !isSpace(data[pos])) ++pos;
+        word.assign(data + start, pos - start);
+        return pos > start;
+    }
+
+    bool readInt(int& value) {
+        skipSpace();
+        if (pos >= size) return false;
+        const char* p = parseInt(data + pos, data + size, value);
+        bool any = p != data + pos;
+        pos = p - data;
+        return any;
+    }
+
+    bool readBool(bool& value) {
+        int x;
+        if (!readInt(x)) return false;
+        value = x != 0;
+        return true;
+    }
+
+    // Parses up to m edge lines from the current position. threads <= 0 picks
+    // the number of online cores.
+    vector<InputEdge> readEdges(long m, bool weighted, int threads = 0) {
+        skipSpace();
+        const char* begin = data + pos;
+        const char* end = data + size;
+        if (threads <= 0) threads = sysconf(_SC_NPROCESSORS_ONLN);
+        long maxThreads = (end - begin) / PARSE_MIN_CHUNK + 1;
+        if (threads > maxThreads) threads = maxThreads;
+        if (threads < 1) threads = 1;
+
+        vector<ParseChunk> chunks(threads);
+        const char* cut = begin;
+        for (int i = 0; i < threads; ++i) {
+            chunks[i].begin = cut;
+            if (i == threads - 1) {
+                cut = end;
+            } else {
+                cut = max(cut, begin + (end - begin) * (i + 1) / threads);
+                const char* nl = (const char*)memchr(cut, '\n', end - cut);
+                cut = nl ? nl + 1 : end;
+            }
+            chunks[i].end = cut;
+            chunks[i].weighted = weighted;
+        }
+
+        // Lines are counted first so every chunk can parse straight into its
+        // slice of the result; blank lines leave gaps that are closed afterwards
+        runParsePass(chunks, true);
+        size_t total = 0;
+        for (ParseChunk& c : chunks) total += c.lines;
+        vector<InputEdge> edges(total);
+        size_t offset = 0;
+        for (ParseChunk& c : chunks) {
+            c.out = edges.data() + offset;
+            offset += c.lines;
+        }
+        runParsePass(chunks, false);
+
+        size_t filled = 0;
+        for (ParseChunk& c : chunks) {
+            if (c.out != edges.data() + filled) {
+                memmove(edges.data() + filled, c.out, c.parsed * sizeof(InputEdge));
+            }
+            filled += c.parsed;
+        }
+        edges.resize(filled);
+        if ((long)edges.size() > m) edges.resize(m);
+        pos = size;
+        return edges;
+    }
+
+private:
+    static bool isSpace(char c) {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+    }
+
+    void skipSpace() {
+        while (pos < size && isSpace(data[pos])) ++pos;
+    }
+
+    const char* data;
+    size_t size;
+    size_t pos;
+    bool mapped;
+    vector<char> buffer;
+};
+
+#endif // EDGELIST_H
@@ -0,0 +1,209 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <vector>
+#include <queue>
+#include <utility>
+#include <functional>
+using namespace std;
+
+// Min-queues of vertices keyed by Key (int by default), shared by Dijkstra and
+// Prim. All of them
+//   update(v, key)  insert v, or lower its key (the new key is never larger)
+//   empty()
+//   pop()           remove and return the vertex with the smallest (key, v)
+// Ties are broken by vertex id, the order priority_queue<pair<int, int>> pops
+// in, so every queue yields the same traversal and the same output.
+
+// The original lazy queue: update() pushes a new pair and pop() skips vertices
+// that were already popped. Holds up to one entry per relaxation, O(m).
+template <class Key = int>
+class LazyBinaryHeap {
+public:
+    explicit LazyBinaryHeap(int n) : done(n, false) {}
+
+    void update(int v, Key key) { pq.push({key, v}); }
+
+    bool empty() {
+        while (!pq.empty() && done[pq.top().second]) pq.pop();
+        return pq.empty();
+    }
+
+    int pop() {
+        empty();
+        int v = pq.top().second;
+        pq.pop();
+        done[v] = true;
+        return v;
+    }
+
+private:
+    priority_queue<pair<Key, int>, vector<pair<Key, int>>, greater<pair<Key, int>>> pq;
+    vector<bool> done;
+};
+
+// Addressable D-ary heap. pos[v] tracks where v sits so update() can sift it
+// up in place; at most n entries are ever stored.
+template <int D, class Key = int>
+class IndexedDaryHeap {
+public:
+    explicit IndexedDaryHeap(int n) : key(n), pos(n, -1) { heap.reserve(n); }
+
+    void update(int v, Key k) {
+        key[v] = k;
+        if (pos[v] < 0) {
+            pos[v] = heap.size();
+            heap.push_back(v);
+        }
+        siftUp(pos[v]);
+    }
+
+    bool empty() const { return heap.empty(); }
+
+    int pop() {
+        int top = heap[0];
+        int last = heap.back();
+        heap.pop_back();
+        pos[top] = -1;
+        if (!heap.empty()) {
+            heap[0] = last;
+            pos[last] = 0;
+            siftDown(0);
+        }
+        return top;
+    }
+
+private:
+    bool less(int a, int b) const {
+        return key[a] < key[b] || (key[a] == key[b] && a < b);
+    }
+
+    void siftUp(int i) {
+        int v = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            if (!less(v, heap[parent])) break;
+            heap[i] = heap[parent];
+            pos[heap[i]] = i;
+            i = parent;
+        }
+        heap[i] = v;
+        pos[v] = i;
+    }
+
+    void siftDown(int i) {
+        int v = heap[i];
+        int size = heap.size();
+        while (true) {
+            int first = i * D + 1;
+            if (first >= size) break;
+            int best = first;
+            int last = min(first + D, size);
+            for (int c = first + 1; c < last; c++) {
+                if (less(heap[c], heap[best])) best = c;
+            }
+            if (!less(heap[best], v)) break;
+            heap[i] = heap[best];
+            pos[heap[i]] = i;
+            i = best;
+        }
+        heap[i] = v;
+        pos[v] = i;
+    }
+
+    vector<int> heap;
+    vector<Key> key;
+    vector<int> pos;
+};
+
+// Pairing heap over a fixed pool of n nodes, linked by index. update() on a
+// queued vertex cuts its subtree and melds it back with the root, O(1);
+// pop() merges the root's children in two passes.
+template <class Key = int>
+class PairingHeap {
+public:
+    explicit PairingHeap(int n) : key(n), child(n, -1), sibling(n, -1), prev(n, -1), queued(n, false), root(-1) {}
+
+    void update(int v, Key k) {
+        key[v] = k;
+        if (!queued[v]) {
+            queued[v] = true;
+            child[v] = sibling[v] = prev[v] = -1;
+            root = meld(root, v);
+        } else if (v != root) {
+            // Unlink v from its parent's child list, then meld the subtree
+            if (child[prev[v]] == v) {
+                child[prev[v]] = sibling[v];
+            } else {
+                sibling[prev[v]] = sibling[v];
+            }
+            if (sibling[v] >= 0) prev[sibling[v]] = prev[v];
+            sibling[v] = prev[v] = -1;
+            root = meld(root, v);
+        }
+    }
+
+    bool empty() const { return root < 0; }
+
+    int pop() {
+        int top = root;
+        queued[top] = false;
+        root = mergePairs(child[top]);
+        if (root >= 0) prev[root] = -1;
+        return top;
+    }
+
+private:
+    bool less(int a, int b) const {
+        return key[a] < key[b] || (key[a] == key[b] && a < b);
+    }
+
+    // Melds two roots, either may be -1
+    int meld(int a, int b) {
+        if (a < 0) return b;
+        if (b < 0) return a;
+        if (less(b, a)) swap(a, b);
+        sibling[b] = child[a];
+        if (child[a] >= 0) prev[child[a]] = b;
+        child[a] = b;
+        prev[b] = a;
+        sibling[a] = -1;
+        return a;
+    }
+
+    int mergePairs(int first) {
+        if (first < 0) return -1;
+        // Left to right: meld neighbours pairwise, chaining the results
+        int paired = -1;
+        while (first >= 0) {
+            int a = first;
+            int b = sibling[a];
+            first = (b >= 0) ? sibling[b] : -1;
+            sibling[a] = prev[a] = -1;
+            if (b >= 0) sibling[b] = prev[b] = -1;
+            int m = meld(a, b);
+            sibling[m] = paired;
+            paired = m;
+        }
+        // Right to left: fold the chain into one tree
+        int result = paired;
+        paired = sibling[paired];
+        sibling[result] = -1;
+        while (paired >= 0) {
+            int next = sibling[paired];
+            sibling[paired] = -1;
+            result = meld(result, paired);
+            paired = next;
+        }
+        return result;
+    }
+
+    vector<Key> key;
+    vector<int> child;
+    vector<int> sibling;
+    vector<int> prev;
+    vector<bool> queued;
+    int root;
+};
+
+#endif // HEAP_H
@@ -0,0 +1,192 @@
+#ifndef MST_H
+#define MST_H
+
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+#include "edgelist.h"
+#include "parallel.h"
+using namespace std;
+
+// Minimum spanning forest of an undirected edge list. Edges are ordered by
+// (weight, input position), a strict total order, so the forest is unique and
+// Boruvka and Kruskal return the same edges.
+// Both return inMst with one flag per input edge.
+
+const uint64_t MST_NO_EDGE = ~0ULL;
+
+// Sortable key: the weight with its sign bit flipped (so unsigned order is
+// signed order) above the edge position
+inline uint64_t mstKey(const InputEdge &e, long index) {
+    return ((uint64_t)((uint32_t)e.w ^ 0x80000000u) << 32) | (uint32_t)index;
+}
+
+// Lock-free union-find: roots are linked with a CAS from the larger id to the
+// smaller one and find() halves paths with plain relaxed stores, which only
+// ever point a vertex at one of its ancestors
+class ConcurrentDsu {
+public:
+    explicit ConcurrentDsu(int n) : parent(n) {
+        for (int i = 0; i < n; i++) parent[i].store(i, memory_order_relaxed);
+    }
+
+    int find(int x) {
+        while (true) {
+            int p = parent[x].load(memory_order_relaxed);
+            if (p == x) return x;
+            int gp = parent[p].load(memory_order_relaxed);
+            if (gp != p) parent[x].store(gp, memory_order_relaxed);
+            x = gp;
+        }
+    }
+
+    // Returns true for exactly one caller when a and b get joined
+    bool unite(int a, int b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return false;
+            if (a < b) swap(a, b);
+            int expected = a;
+            if (parent[a].compare_exchange_weak(expected, b, memory_order_acq_rel)) return true;
+        }
+    }
+
+private:
+    vector<atomic<int>> parent;
+};
+
+// Parallel Boruvka: each round every component picks its lightest outgoing
+// edge (an atomic min on the 64-bit key), all picks are united at once and
+// edges inside a component are dropped before the next round
+inline vector<char> boruvkaMst(int n, const vector<InputEdge> &edges, long threads) {
+    long m = edges.size();
+    vector<char> inMst(m, 0);
+    ConcurrentDsu dsu(n);
+    vector<atomic<uint64_t>> best(n);
+    parallelFor(threads, n, [&](long, long begin, long end) {
+        for (long v = begin; v < end; v++) best[v].store(MST_NO_EDGE, memory_order_relaxed);
+    });
+
+    vector<int> live(m), next(m);
+    parallelFor(threads, m, [&](long, long begin, long end) {
+        for (long i = begin; i < end; i++) live[i] = i;
+    });
+    vector<char> keep(m);
+    vector<long> kept(threads + 1);
+
+    while (!live.empty()) {
+        long count = live.size();
+        parallelFor(threads, count, [&](long, long begin, long end) {
+            for (long i = begin; i < end; i++) {
+                const InputEdge &e = edges[live[i]];
+                int ru = dsu.find(e.u), rv = dsu.find(e.v);
+                if (ru == rv) continue;
+                uint64_t key = mstKey(e, live[i]);
+                for (int r : {ru, rv}) {
+                    uint64_t cur = best[r].load(memory_order_relaxed);
+                    while (key < cur && !best[r].compare_exchange_weak(cur, key, memory_order_relaxed)) {}
+                }
+            }
+        });
+
+        parallelFor(threads, n, [&](long, long begin, long end) {
+            for (long v = begin; v < end; v++) {
+                uint64_t key = best[v].load(memory_order_relaxed);
+                if (key == MST_NO_EDGE) continue;
+                best[v].store(MST_NO_EDGE, memory_order_relaxed);
+                long index = (uint32_t)key;
+                if (dsu.unite(edges[index].u, edges[index].v)) inMst[index] = 1;
+            }
+        });
+
+        // Keep the edges that still join two components, in order
+        parallelFor(threads, count, [&](long t, long begin, long end) {
+            long c = 0;
+            for (long i = begin; i < end; i++) {
+                const InputEdge &e = edges[live[i]];
+                keep[i] = dsu.find(e.u) != dsu.find(e.v);
+                c += keep[i];
+            }
+            kept[t + 1] = c;
+        });
+        long parts = max(threads, 1L);
+        for (long t = 0; t < parts; t++) kept[t + 1] += kept[t];
+        parallelFor(threads, count, [&](long t, long begin, long end) {
+            long out = kept[t];
+            for (long i = begin; i < end; i++) {
+                if (keep[i]) next[out++] = live[i];
+            }
+        });
+        next.resize(kept[parts]);
+        live.swap(next);
+        next.resize(live.size());
+    }
+    return inMst;
+}
+
+// Sorts keys with one std::sort per thread followed by rounds of pairwise
+// merges, each round merging its pairs in parallel
+inline void parallelSortKeys(vector<uint64_t> &keys, long threads) {
+    long count = keys.size();
+    long parts = max(1L, min(threads, count / 4096 + 1));
+    vector<long> bound(parts + 1);
+    for (long i = 0; i <= parts; i++) bound[i] = count * i / parts;
+
+    parallelFor(parts, parts, [&](long, long begin, long end) {
+        for (long i = begin; i < end; i++) sort(keys.begin() + bound[i], keys.begin() + bound[i + 1]);
+    });
+    for (long width = 1; width < parts; width *= 2) {
+        long pairs = (parts + 2 * width - 1) / (2 * width);
+        parallelFor(min(pairs, threads), pairs, [&](long, long begin, long end) {
+            for (long p = begin; p < end; p++) {
+                long lo = p * 2 * width;
+                long mid = min(lo + width, parts), hi = min(lo + 2 * width, parts);
+                if (mid < hi) {
+                    inplace_merge(keys.begin() + bound[lo], keys.begin() + bound[mid], keys.begin() + bound[hi]);
+                }
+            }
+        });
+    }
+}
+
+// Kruskal over the parallel-sorted keys with a sequential path-compressed,
+// union-by-size DSU
+inline vector<char> kruskalMst(int n, const vector<InputEdge> &edges, long threads) {
+    long m = edges.size();
+    vector<char> inMst(m, 0);
+    vector<uint64_t> keys(m);
+    parallelFor(threads, m, [&](long, long begin, long end) {
+        for (long i = begin; i < end; i++) keys[i] = mstKey(edges[i], i);
+    });
+    parallelSortKeys(keys, threads);
+
+    vector<int> parent(n), size(n, 1);
+    for (int i = 0; i < n; i++) parent[i] = i;
+    auto find = [&](int x) {
+        int root = x;
+        while (parent[root] != root) root = parent[root];
+        while (parent[x] != root) {
+            int up = parent[x];
+            parent[x] = root;
+            x = up;
+        }
+        return root;
+    };
+
+    int joined = 0;
+    for (long i = 0; i < m && joined < n - 1; i++) {
+        long index = (uint32_t)keys[i];
+        int a = find(edges[index].u), b = find(edges[index].v);
+        if (a == b) continue;
+        if (size[a] < size[b]) swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+        inMst[index] = 1;
+        joined++;
+    }
+    return inMst;
+}
+
+#endif // MST_H
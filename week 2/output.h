@@ -0,0 +1,108 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <unistd.h>
+using namespace std;
+
+// How results are emitted:
+//   text    "a b\n" per pair, same as the cout << ... << endl output
+//   binary  two native-endian int32 per pair
+//   none    nothing; for timing the algorithms alone
+enum OutputMode { OUTPUT_TEXT, OUTPUT_BINARY, OUTPUT_NONE };
+
+inline bool parseOutputMode(const string &name, OutputMode &mode) {
+    if (name == "text") mode = OUTPUT_TEXT;
+    else if (name == "binary") mode = OUTPUT_BINARY;
+    else if (name == "none") mode = OUTPUT_NONE;
+    else return false;
+    return true;
+}
+
+const size_t OUTPUT_BUFFER_SIZE = 1 << 20;
+const size_t OUTPUT_MAX_PAIR = 24; // "-2147483648 -2147483648\n"
+
+// Formats result pairs into a 1 MB buffer and hands it to write() when full,
+// instead of flushing the stream after every line
+class ResultWriter {
+public:
+    explicit ResultWriter(OutputMode outputMode = OUTPUT_TEXT, int outputFd = STDOUT_FILENO)
+        : mode(outputMode), fd(outputFd), buffer(OUTPUT_BUFFER_SIZE), used(0) {}
+
+    ~ResultWriter() { flush(); }
+
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    void setMode(OutputMode outputMode) {
+        flush();
+        mode = outputMode;
+    }
+
+    void pair(int a, int b) {
+        if (mode == OUTPUT_NONE) return;
+        if (used + OUTPUT_MAX_PAIR > buffer.size()) flush();
+        char *p = buffer.data() + used;
+        if (mode == OUTPUT_BINARY) {
+            memcpy(p, &a, sizeof(int));
+            memcpy(p + sizeof(int), &b, sizeof(int));
+            p += 2 * sizeof(int);
+        } else {
+            p = formatInt(p, a);
+            *p++ = ' ';
+            p = formatInt(p, b);
+            *p++ = '\n';
+        }
+        used = p - buffer.data();
+    }
+
+    void flush() {
+        const char *p = buffer.data();
+        while (used > 0) {
+            ssize_t done = write(fd, p, used);
+            if (done <= 0) break;
+            p += done;
+            used -= done;
+        }
+        used = 0;
+    }
+
+private:
+    static char *formatInt(char *p, int x) {
+        static const char digitPairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+        unsigned int v = x;
+        if (x < 0) {
+            *p++ = '-';
+            v = 0u - v;
+        }
+        char tmp[10];
+        char *t = tmp + sizeof(tmp);
+        while (v >= 100) {
+            unsigned int r = v % 100;
+            v /= 100;
+            t -= 2;
+            memcpy(t, digitPairs + 2 * r, 2);
+        }
+        if (v >= 10) {
+            t -= 2;
+            memcpy(t, digitPairs + 2 * v, 2);
+        } else {
+            *--t = '0' + v;
+        }
+        size_t len = tmp + sizeof(tmp) - t;
+        memcpy(p, t, len);
+        return p + len;
+    }
+
+    OutputMode mode;
+    int fd;
+    vector<char> buffer;
+    size_t used;
+};
+
+#endif // OUTPUT_H
@@ -0,0 +1,39 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <vector>
+#include <functional>
+#include <pthread.h>
+using namespace std;
+
+struct RangeJob {
+    long threadNum;
+    long begin;
+    long end;
+    const function<void(long, long, long)>* body;
+};
+
+inline void* runRangeJob(void* arg) {
+    RangeJob* job = (RangeJob*)arg;
+    (*job->body)(job->threadNum, job->begin, job->end);
+    return nullptr;
+}
+
+// Split [0, count) into threadCount contiguous ranges and run body(thread, begin, end) on each
+inline void parallelFor(long threadCount, long count, const function<void(long, long, long)>& body) {
+    if (threadCount <= 1) {
+        body(0, 0, count);
+        return;
+    }
+    vector<pthread_t> threads(threadCount);
+    vector<RangeJob> jobs(threadCount);
+    for (long i = 0; i < threadCount; i++) {
+        jobs[i] = {i, count * i / threadCount, count * (i + 1) / threadCount, &body};
+        pthread_create(&threads[i], nullptr, runRangeJob, &jobs[i]);
+    }
+    for (long i = 0; i < threadCount; i++) {
+        pthread_join(threads[i], nullptr);
+    }
+}
+
+#endif // PARALLEL_H
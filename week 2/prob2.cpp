@@ -1,310 +1,342 @@
-#include <iostream>
-#include <vector>
-#include <list>
-#include <queue>
-#include <climits>
-#include <deque>
-using namespace std;
-
-class Graph {
-protected:
-    int n, m;
-    bool directed;
-public:
-    Graph(bool isDirected) {
-        directed = isDirected;
-    }
-    virtual void getInput() = 0;
-    virtual void algo() = 0;
-};
-
-class BFSGraph : public Graph {
-    vector<vector<int>> adj;
-
-public:
-    BFSGraph(bool isDirected) : Graph(isDirected) {}
-
-    void getInput() {
-        cin >> n >> m;
-        adj = vector<vector<int>>(n);
-        for (int i = 0; i < m; i++) {
-            int u, v;
-            cin >> u >> v;
-            adj[u].push_back(v);
-            if (!directed) {
-                adj[v].push_back(u);
-            }
-        }
-    }
-
-    void algo() {
-        vector<bool> visited(adj.size(), false);
-        vector<pair<int, int>> res;
-        queue<pair<int, int>> queue;
-        queue.push({0, 0});
-        visited[0] = true;
-
-        while (!queue.empty()) {
-            pair<int, int> front = queue.front();
-            int curr = front.first;
-            int level = front.second;
-            queue.pop();
-
-            res.push_back({curr, level});
-
-            for (int i = 0; i < adj[curr].size(); i++) {
-                int adjVert = adj[curr][i];
-                if (!visited[adjVert]) {
-                    visited[adjVert] = true;
-                    queue.push({adjVert, level + 1});
-                }
-            }
-        }
-
-        for (int i = 0; i < res.size(); i++) {
-            cout << res[i].first << " " << res[i].second << endl;
-        }
-    }
-};
-
-class DFSGraph : public Graph {
-    vector<vector<int>> adj;
-
-public:
-    DFSGraph(bool isDirected) : Graph(isDirected) {}
-
-    void getInput() {
-        cin >> n >> m;
-        adj = vector<vector<int>>(n);
-        for (int i = 0; i < m; i++) {
-            int u, v;
-            cin >> u >> v;
-            adj[u].push_back(v);
-            if (!directed) {
-                adj[v].push_back(u);
-            }
-        }
-    }
-
-    void dfsRec(vector<vector<int>> &adj, vector<bool> &visited, int s, int level, vector<pair<int, int>> &res) {
-        visited[s] = true;
-        res.push_back({s, level});
-        for (int adjVert : adj[s]) {
-            if (!visited[adjVert]) {
-                dfsRec(adj, visited, adjVert, level + 1, res);
-            }
-        }
-    }
-
-    void algo() {
-        vector<bool> visited(adj.size(), false);
-        vector<pair<int, int>> res;
-        dfsRec(adj, visited, 0, 0, res);
-        for (int i = 0; i < res.size(); i++) {
-            cout << res[i].first << " " << res[i].second << endl;
-        }
-    }
-};
-
-class DijkstraGraph : public Graph {
-    vector<list<pair<int, int>>> adj;
-
-public:
-    DijkstraGraph(bool isDirected) : Graph(isDirected) {}
-
-    void getInput() {
-        cin >> n >> m;
-        adj = vector<list<pair<int, int>>>(n);
-        for (int i = 0; i < m; i++) {
-            int u, v, w;
-            cin >> u >> v >> w;
-            adj[u].push_back({v, w});
-            if (!directed) {
-                adj[v].push_back({u, w});
-            }
-        }
-    }
-
-    void algo() {
-        vector<int> visited(n, false);
-        vector<int> dist(n, INT_MAX);
-        vector<int> parent(n, -1);
-
-        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
-        dist[0] = 0;
-        pq.push({0, 0});
-
-        while (!pq.empty()) {
-            pair<int, int> top = pq.top();
-            pq.pop();
-            int d = top.first;
-            int u = top.second;
-
-            if (visited[u]) continue;
-            visited[u] = true;
-
-            for(auto &edge: adj[u]){
-                int v = edge.first;
-                int w = edge.second;
-                if (!visited[v] && dist[u] + w < dist[v]) {
-                    dist[v] = dist[u] + w;
-                    parent[v] = u;
-                    pq.push({dist[v], v});
-                }
-            }
-        }
-
-        for (int v = 1; v < n; v++) {
-            if (parent[v] != -1) {
-                cout << parent[v] << " " << v << endl;
-            }
-        }
-    }
-};
-
-class WBFSGraph : public Graph {
-    vector<list<pair<int, int>>> adj;
-
-public:
-    WBFSGraph(bool isDirected) : Graph(isDirected) {}
-
-    void getInput() {
-        cin >> n >> m;
-        adj = vector<list<pair<int, int>>>(n);
-        for (int i = 0; i < m; i++) {
-            int u, v, w;
-            cin >> u >> v >> w;
-            adj[u].push_back({v, w});
-            if (!directed) {
-                adj[v].push_back({u, w});
-            }
-        }
-    }
-
-    void algo() {
-        vector<int> dist(n, INT_MAX);
-        vector<int> parent(n, -1);
-        vector<bool> visited(n, false);
-
-        deque<int> dq;
-        dist[0] = 0;
-        dq.push_front(0);
-
-        while (!dq.empty()) {
-            int u = dq.front();
-            dq.pop_front();
-
-            if (visited[u]) continue;
-            visited[u] = true;
-
-            for (auto &edge : adj[u]) {
-                int v = edge.first;
-                int w = edge.second;
-                if (dist[u] + w < dist[v]) {
-                    dist[v] = dist[u] + w;
-                    parent[v] = u;
-                    if (w == 0) {
-                        dq.push_front(v);
-                    } else {
-                        dq.push_back(v);
-                    }
-                }
-            }
-        }
-
-        for (int v = 0; v < n; v++) {
-            if (parent[v] != -1) {
-                cout << parent[v] << " " << v << endl;
-            }
-        }
-    }
-};
-
-class PrimGraph : public Graph {
-    vector<list<pair<int, int>>> adj;
-
-public:
-    PrimGraph(bool isDirected) : Graph(isDirected) {}
-
-    void getInput() {
-        cin >> n >> m;
-        adj = vector<list<pair<int, int>>>(n);
-        for (int i = 0; i < m; i++) {
-            int u, v, w;
-            cin >> u >> v >> w;
-            adj[u].push_back({v, w});
-            adj[v].push_back({u, w});
-        }
-    }
-
-    void algo() {
-        vector<bool> visited(n, false);
-        vector<int> parent(n, -1);
-        vector<int> key(n, INT_MAX);
-
-        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
-        key[0] = 0;
-        pq.push({0, 0});
-
-        while (!pq.empty()) {
-            int k = pq.top().first;
-            int u = pq.top().second;
-            pq.pop();
-
-            if (visited[u]) continue;
-            visited[u] = true;
-
-            for (auto &edge : adj[u]) {
-                int v = edge.first;
-                int w = edge.second;
-                if (!visited[v] && w < key[v]) {
-                    key[v] = w;
-                    parent[v] = u;
-                    pq.push({key[v], v});
-                }
-            }
-        }
-
-        for (int v = 1; v < n; v++) {
-            if (parent[v] != -1) {
-                cout << parent[v] << " " << v << endl;
-            }
-        }
-    }
-};
-
-
-
-int main() {
-    freopen("inp.txt", "r", stdin);
-    
-    string algo;
-    cin >> algo;
-    
-    bool isDirected;
-    cin >> isDirected;
-    Graph* g = NULL;
-
-    if (algo == "BFS") {
-        g = new BFSGraph(isDirected);
-    }
-    else if (algo == "DFS") {
-        g = new DFSGraph(isDirected);
-    }
-    else if (algo == "DJK") {
-        g = new DijkstraGraph(isDirected);
-    }
-    else if (algo == "WBFS") {
-        g = new WBFSGraph(isDirected);
-    }
-    else if (algo == "PRM") {
-        g = new PrimGraph(isDirected);
-    }
-
-    if (g != NULL) {
-        g->getInput();
-        g->algo();
-    }
-
-    return 0;
-}
\ No newline at end of file
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <climits>
+#include <limits>
+#include <deque>
+#include <unistd.h>
+#include "adjacency.h"
+#include "output.h"
+#include "heap.h"
+#include "mst.h"
+using namespace std;
+
+// Storage is one of the layouts in adjacency.h; all of them are built from the
+// parsed edge array by the same getInput(). Each algorithm class below adds a
+// non-virtual algo() and is instantiated per storage/queue combination in
+// ALGORITHMS, so every loop is compiled for concrete types.
+template <class Storage>
+class Graph {
+protected:
+    int n, m;
+    bool directed;
+    bool bothWays; // store v -> u for every edge u -> v
+    Storage adj;
+public:
+    Graph(bool isDirected, bool alwaysBothWays = false) {
+        n = m = 0;
+        directed = isDirected;
+        bothWays = alwaysBothWays || !isDirected;
+    }
+
+    void getInput(InputFile &in) {
+        in.readInt(n);
+        in.readInt(m);
+        adj = Storage(n, in.readEdges(m, Storage::weighted), bothWays);
+    }
+};
+
+// Brings the base members into scope of the class templates deriving from Graph
+#define GRAPH_MEMBERS(Storage) \
+    using Graph<Storage>::n;   \
+    using Graph<Storage>::m;   \
+    using Graph<Storage>::adj
+
+template <class Storage>
+class BFSGraph : public Graph<Storage> {
+    GRAPH_MEMBERS(Storage);
+
+public:
+    BFSGraph(bool isDirected) : Graph<Storage>(isDirected) {}
+
+    void algo(ResultWriter &out) {
+        vector<bool> visited(n, false);
+        vector<pair<int, int>> res;
+        queue<pair<int, int>> queue;
+        queue.push({0, 0});
+        visited[0] = true;
+
+        while (!queue.empty()) {
+            pair<int, int> front = queue.front();
+            int curr = front.first;
+            int level = front.second;
+            queue.pop();
+
+            res.push_back({curr, level});
+
+            for (int i = 0; i < adj[curr].size(); i++) {
+                int adjVert = adj[curr][i];
+                if (!visited[adjVert]) {
+                    visited[adjVert] = true;
+                    queue.push({adjVert, level + 1});
+                }
+            }
+        }
+
+        for (int i = 0; i < res.size(); i++) {
+            out.pair(res[i].first, res[i].second);
+        }
+    }
+};
+
+template <class Storage>
+class DFSGraph : public Graph<Storage> {
+    GRAPH_MEMBERS(Storage);
+
+public:
+    DFSGraph(bool isDirected) : Graph<Storage>(isDirected) {}
+
+    void dfsRec(const Storage &adj, vector<bool> &visited, int s, int level, vector<pair<int, int>> &res) {
+        visited[s] = true;
+        res.push_back({s, level});
+        for (int adjVert : adj[s]) {
+            if (!visited[adjVert]) {
+                dfsRec(adj, visited, adjVert, level + 1, res);
+            }
+        }
+    }
+
+    void algo(ResultWriter &out) {
+        vector<bool> visited(n, false);
+        vector<pair<int, int>> res;
+        dfsRec(adj, visited, 0, 0, res);
+        for (int i = 0; i < res.size(); i++) {
+            out.pair(res[i].first, res[i].second);
+        }
+    }
+};
+
+// Queue is one of the heaps in heap.h, keyed by Storage::Weight
+template <class Storage, class Queue>
+class DijkstraGraph : public Graph<Storage> {
+    GRAPH_MEMBERS(Storage);
+    typedef typename Storage::Weight Weight;
+
+public:
+    DijkstraGraph(bool isDirected) : Graph<Storage>(isDirected) {}
+
+    void algo(ResultWriter &out) {
+        vector<int> visited(n, false);
+        vector<Weight> dist(n, numeric_limits<Weight>::max());
+        vector<int> parent(n, -1);
+
+        Queue pq(n);
+        dist[0] = 0;
+        pq.update(0, 0);
+
+        while (!pq.empty()) {
+            int u = pq.pop();
+            visited[u] = true;
+
+            for(auto &edge: adj[u]){
+                int v = edge.first;
+                Weight w = edge.second;
+                if (!visited[v] && dist[u] + w < dist[v]) {
+                    dist[v] = dist[u] + w;
+                    parent[v] = u;
+                    pq.update(v, dist[v]);
+                }
+            }
+        }
+
+        for (int v = 1; v < n; v++) {
+            if (parent[v] != -1) {
+                out.pair(parent[v], v);
+            }
+        }
+    }
+};
+
+template <class Storage>
+class WBFSGraph : public Graph<Storage> {
+    GRAPH_MEMBERS(Storage);
+    typedef typename Storage::Weight Weight;
+
+public:
+    WBFSGraph(bool isDirected) : Graph<Storage>(isDirected) {}
+
+    void algo(ResultWriter &out) {
+        vector<Weight> dist(n, numeric_limits<Weight>::max());
+        vector<int> parent(n, -1);
+        vector<bool> visited(n, false);
+
+        deque<int> dq;
+        dist[0] = 0;
+        dq.push_front(0);
+
+        while (!dq.empty()) {
+            int u = dq.front();
+            dq.pop_front();
+
+            if (visited[u]) continue;
+            visited[u] = true;
+
+            for (auto &edge : adj[u]) {
+                int v = edge.first;
+                Weight w = edge.second;
+                if (dist[u] + w < dist[v]) {
+                    dist[v] = dist[u] + w;
+                    parent[v] = u;
+                    if (w == 0) {
+                        dq.push_front(v);
+                    } else {
+                        dq.push_back(v);
+                    }
+                }
+            }
+        }
+
+        for (int v = 0; v < n; v++) {
+            if (parent[v] != -1) {
+                out.pair(parent[v], v);
+            }
+        }
+    }
+};
+
+// Always reads the input as undirected
+template <class Storage, class Queue>
+class PrimGraph : public Graph<Storage> {
+    GRAPH_MEMBERS(Storage);
+    typedef typename Storage::Weight Weight;
+
+public:
+    PrimGraph(bool isDirected) : Graph<Storage>(isDirected, true) {}
+
+    void algo(ResultWriter &out) {
+        vector<bool> visited(n, false);
+        vector<int> parent(n, -1);
+        vector<Weight> key(n, numeric_limits<Weight>::max());
+
+        Queue pq(n);
+        key[0] = 0;
+        pq.update(0, 0);
+
+        while (!pq.empty()) {
+            int u = pq.pop();
+            visited[u] = true;
+
+            for (auto &edge : adj[u]) {
+                int v = edge.first;
+                Weight w = edge.second;
+                if (!visited[v] && w < key[v]) {
+                    key[v] = w;
+                    parent[v] = u;
+                    pq.update(v, key[v]);
+                }
+            }
+        }
+
+        for (int v = 1; v < n; v++) {
+            if (parent[v] != -1) {
+                out.pair(parent[v], v);
+            }
+        }
+    }
+};
+
+// Minimum spanning forest by parallel Boruvka or by Kruskal over a parallel
+// sort. Prints the tree like PrimGraph: the forest is rooted at 0 and
+// "parent v" is printed for every other vertex reachable from 0.
+template <bool useKruskal>
+class MSTGraph : public Graph<EdgeArray> {
+public:
+    MSTGraph(bool isDirected) : Graph<EdgeArray>(isDirected) {}
+
+    void algo(ResultWriter &out) {
+        const vector<InputEdge> &edges = adj.edges;
+        long threads = max(1L, sysconf(_SC_NPROCESSORS_ONLN));
+        vector<char> inMst = useKruskal ? kruskalMst(n, edges, threads) : boruvkaMst(n, edges, threads);
+
+        vector<InputEdge> tree;
+        for (size_t i = 0; i < edges.size(); i++) {
+            if (inMst[i]) tree.push_back(edges[i]);
+        }
+        FlatAdjacency forest(n, tree, true);
+
+        vector<int> parent(n, -1);
+        vector<bool> visited(n, false);
+        vector<int> stack;
+        if (n > 0) {
+            stack.push_back(0);
+            visited[0] = true;
+        }
+        while (!stack.empty()) {
+            int u = stack.back();
+            stack.pop_back();
+            for (auto &edge : forest[u]) {
+                int v = edge.first;
+                if (!visited[v]) {
+                    visited[v] = true;
+                    parent[v] = u;
+                    stack.push_back(v);
+                }
+            }
+        }
+
+        for (int v = 1; v < n; v++) {
+            if (parent[v] != -1) {
+                out.pair(parent[v], v);
+            }
+        }
+    }
+};
+
+
+
+template <class G>
+void runGraph(InputFile &in, bool isDirected, ResultWriter &out) {
+    G g(isDirected);
+    g.getInput(in);
+    g.algo(out);
+}
+
+typedef WeightedAdjacency<long long> WideAdjacency;
+
+struct AlgorithmEntry {
+    const char *name;
+    void (*run)(InputFile &in, bool isDirected, ResultWriter &out);
+};
+
+// Every specialization main() can pick from
+const AlgorithmEntry ALGORITHMS[] = {
+    {"BFS", runGraph<BFSGraph<FlatNeighbours>>},
+    {"DFS", runGraph<DFSGraph<FlatNeighbours>>},
+    {"DJK", runGraph<DijkstraGraph<FlatAdjacency, LazyBinaryHeap<int>>>},
+    {"DJK_DARY", runGraph<DijkstraGraph<FlatAdjacency, IndexedDaryHeap<4, int>>>},
+    {"DJK_PAIRING", runGraph<DijkstraGraph<FlatAdjacency, PairingHeap<int>>>},
+    {"DJK64", runGraph<DijkstraGraph<WideAdjacency, IndexedDaryHeap<4, long long>>>},
+    {"WBFS", runGraph<WBFSGraph<FlatAdjacency>>},
+    {"PRM", runGraph<PrimGraph<FlatAdjacency, LazyBinaryHeap<int>>>},
+    {"PRM_DARY", runGraph<PrimGraph<FlatAdjacency, IndexedDaryHeap<4, int>>>},
+    {"PRM_PAIRING", runGraph<PrimGraph<FlatAdjacency, PairingHeap<int>>>},
+    {"BRV", runGraph<MSTGraph<false>>},
+    {"KRS", runGraph<MSTGraph<true>>},
+};
+
+// Optional argument: output mode, text (default), binary or none
+int main(int argc, char* argv[]) {
+    OutputMode mode = OUTPUT_TEXT;
+    if (argc > 1 && !parseOutputMode(argv[1], mode)) {
+        cout << "Output mode: text, binary or none" << endl;
+        return 0;
+    }
+    ResultWriter out(mode);
+    
+    InputFile in("inp.txt");
+    
+    string algo;
+    in.readWord(algo);
+    
+    bool isDirected = false;
+    in.readBool(isDirected);
+
+    for (const AlgorithmEntry &entry : ALGORITHMS) {
+        if (algo == entry.name) {
+            entry.run(in, isDirected, out);
+            break;
+        }
+    }
+
+    return 0;
+}
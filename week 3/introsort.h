@@ -0,0 +1,126 @@
+#ifndef INTROSORT_H
+#define INTROSORT_H
+
+#include <vector>
+#include <utility>
+
+// Introsort: quicksort with a ninther (or median-of-3) pivot and a three-way
+// partition, so runs of equal keys are placed in one pass and never recursed
+// into again. Ranges below INTRO_INSERTION_CUTOFF are left to one final
+// insertion sort pass. If the recursion gets deeper than 2 log2(n) the range
+// falls back to heapsort, which caps the worst case at O(n log n). Only the
+// smaller side is recursed into; the larger one continues in the loop, so the
+// stack stays O(log n) deep.
+
+const int INTRO_INSERTION_CUTOFF = 24;
+const int INTRO_NINTHER_THRESHOLD = 128;
+
+template <class T>
+void introSiftDown(T* a, long n, long i) {
+    T v = a[i];
+    while (true) {
+        long child = 2 * i + 1;
+        if (child >= n) break;
+        if (child + 1 < n && a[child] < a[child + 1]) child++;
+        if (!(v < a[child])) break;
+        a[i] = a[child];
+        i = child;
+    }
+    a[i] = v;
+}
+
+template <class T>
+void introHeapSort(T* a, long n) {
+    for (long i = n / 2 - 1; i >= 0; i--)
+        introSiftDown(a, n, i);
+    for (long i = n - 1; i > 0; i--) {
+        std::swap(a[0], a[i]);
+        introSiftDown(a, i, 0);
+    }
+}
+
+template <class T>
+void introInsertionSort(T* a, long n) {
+    for (long i = 1; i < n; i++) {
+        T v = a[i];
+        long j = i;
+        while (j > 0 && v < a[j - 1]) {
+            a[j] = a[j - 1];
+            j--;
+        }
+        a[j] = v;
+    }
+}
+
+// Index of the median of a[i], a[j], a[k]
+template <class T>
+long introMedian3(const T* a, long i, long j, long k) {
+    if (a[i] < a[j]) {
+        if (a[j] < a[k]) return j;
+        return a[i] < a[k] ? k : i;
+    }
+    if (a[i] < a[k]) return i;
+    return a[j] < a[k] ? k : j;
+}
+
+template <class T>
+long introPivot(const T* a, long n) {
+    long mid = n / 2;
+    if (n < INTRO_NINTHER_THRESHOLD) return introMedian3(a, 0, mid, n - 1);
+    // Tukey's ninther: the median of three medians of three
+    long s = n / 8;
+    long lo = introMedian3(a, 0, s, 2 * s);
+    long mi = introMedian3(a, mid - s, mid, mid + s);
+    long hi = introMedian3(a, n - 1 - 2 * s, n - 1 - s, n - 1);
+    return introMedian3(a, lo, mi, hi);
+}
+
+template <class T>
+void introSortLoop(T* a, long n, int depthLimit) {
+    while (n > INTRO_INSERTION_CUTOFF) {
+        if (depthLimit-- == 0) {
+            introHeapSort(a, n);
+            return;
+        }
+
+        // Dijkstra's three-way partition: [0, lt) < pivot, [lt, gt] == pivot, (gt, n) > pivot
+        T pivot = a[introPivot(a, n)];
+        long lt = 0, i = 0, gt = n - 1;
+        while (i <= gt) {
+            if (a[i] < pivot) {
+                std::swap(a[lt++], a[i++]);
+            } else if (pivot < a[i]) {
+                std::swap(a[i], a[gt--]);
+            } else {
+                i++;
+            }
+        }
+
+        long leftSize = lt, rightSize = n - gt - 1;
+        if (leftSize < rightSize) {
+            introSortLoop(a, leftSize, depthLimit);
+            a += gt + 1;
+            n = rightSize;
+        } else {
+            introSortLoop(a + gt + 1, rightSize, depthLimit);
+            n = leftSize;
+        }
+    }
+}
+
+template <class T>
+void introSort(T* a, long n) {
+    if (n < 2) return;
+    int depthLimit = 0;
+    for (long k = n; k > 1; k >>= 1) depthLimit += 2;
+    introSortLoop(a, n, depthLimit);
+    // Every element is now within its unsorted block of at most the cutoff
+    introInsertionSort(a, n);
+}
+
+template <class T>
+void introSort(std::vector<T>& arr) {
+    introSort(arr.data(), (long)arr.size());
+}
+
+#endif // INTROSORT_H
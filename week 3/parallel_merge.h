@@ -0,0 +1,197 @@
+#ifndef PARALLEL_MERGE_H
+#define PARALLEL_MERGE_H
+
+#include <vector>
+#include <algorithm>
+#include <pthread.h>
+using namespace std;
+
+// Merge sort that allocates a single n-element scratch buffer up front. Every
+// level merges from one of the two arrays into the other instead of copying
+// back, so each element is moved once per level.
+//
+//   1. the input is cut into one chunk per thread and the chunks are sorted in
+//      parallel by a sequential ping-pong merge sort
+//   2. rounds of pairwise merges follow; each round splits its output into one
+//      equal slice per thread along the merge path, so all threads stay busy
+//      even when only two runs are left
+//
+// One team of threads does both steps, with a barrier between rounds, so
+// threads are started once per sort rather than once per round. The chunks
+// are sorted into whichever array makes the last round land back in the input.
+
+const long PMERGE_INSERTION_CUTOFF = 32;
+const long PMERGE_MIN_CHUNK = 8192;
+
+template <class T>
+void pmergeInsertionSort(T* a, long n) {
+    for (long i = 1; i < n; i++) {
+        T v = a[i];
+        long j = i;
+        while (j > 0 && v < a[j - 1]) {
+            a[j] = a[j - 1];
+            j--;
+        }
+        a[j] = v;
+    }
+}
+
+// Stable merge of a[0, lenA) and b[0, lenB) into out
+template <class T>
+void pmergeMerge(const T* a, long lenA, const T* b, long lenB, T* out) {
+    long i = 0, j = 0;
+    while (i < lenA && j < lenB) {
+        // Branch-free select; the comparison result is unpredictable on random input
+        bool takeB = b[j] < a[i];
+        *out++ = takeB ? b[j] : a[i];
+        j += takeB;
+        i += !takeB;
+    }
+    out = copy(a + i, a + lenA, out);
+    copy(b + j, b + lenB, out);
+}
+
+// Sorts src[0, n), leaving the result in dst when intoDst is set and in src
+// otherwise; the other array is scratch. Each half is sorted into the array
+// the final merge reads from.
+template <class T>
+void pmergeSortRun(T* src, T* dst, long n, bool intoDst) {
+    if (n <= PMERGE_INSERTION_CUTOFF) {
+        pmergeInsertionSort(src, n);
+        if (intoDst) copy(src, src + n, dst);
+        return;
+    }
+    long half = n / 2;
+    pmergeSortRun(src, dst, half, !intoDst);
+    pmergeSortRun(src + half, dst + half, n - half, !intoDst);
+    if (intoDst) {
+        pmergeMerge(src, half, src + half, n - half, dst);
+    } else {
+        pmergeMerge(dst, half, dst + half, n - half, src);
+    }
+}
+
+// Number of elements of a among the first d outputs of merging a and b
+template <class T>
+long pmergePathSplit(const T* a, long lenA, const T* b, long lenB, long d) {
+    long lo = max(0L, d - lenB), hi = min(d, lenA);
+    while (lo < hi) {
+        long mid = (lo + hi) / 2;
+        if (!(b[d - mid - 1] < a[mid])) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+template <class T>
+struct PMergeTeam {
+    T* a;
+    T* buf;
+    long n;
+    long threads;
+    long chunks;
+    bool inScratch;
+    vector<long> bound;
+    pthread_barrier_t barrier;
+};
+
+template <class T>
+struct PMergeThreadData {
+    long threadNum;
+    PMergeTeam<T>* team;
+};
+
+// Output slice [begin, end) of the round that merges runs of width chunks
+template <class T>
+void pmergeRoundSlice(const T* src, T* dst, const vector<long>& bound, long chunks, long width, long begin, long end) {
+    // Walk the pairs of runs that overlap this slice
+    long pos = begin;
+    while (pos < end) {
+        long pair = upper_bound(bound.begin(), bound.end(), pos) - bound.begin() - 1;
+        pair -= pair % (2 * width);
+        long lo = bound[pair];
+        long mid = bound[min(pair + width, chunks)];
+        long hi = bound[min(pair + 2 * width, chunks)];
+        long stop = min(end, hi);
+
+        const T* left = src + lo;
+        const T* right = src + mid;
+        long lenA = mid - lo, lenB = hi - mid;
+        long i0 = pmergePathSplit(left, lenA, right, lenB, pos - lo);
+        long i1 = pmergePathSplit(left, lenA, right, lenB, stop - lo);
+        long j0 = pos - lo - i0, j1 = stop - lo - i1;
+        pmergeMerge(left + i0, i1 - i0, right + j0, j1 - j0, dst + pos);
+        pos = stop;
+    }
+}
+
+template <class T>
+void* pmergeWorker(void* arg) {
+    PMergeThreadData<T>* data = (PMergeThreadData<T>*)arg;
+    PMergeTeam<T>* team = data->team;
+    long t = data->threadNum;
+    const vector<long>& bound = team->bound;
+
+    if (t < team->chunks) {
+        pmergeSortRun(team->a + bound[t], team->buf + bound[t], bound[t + 1] - bound[t], team->inScratch);
+    }
+
+    T* src = team->inScratch ? team->buf : team->a;
+    T* dst = team->inScratch ? team->a : team->buf;
+    long begin = team->n * t / team->threads, end = team->n * (t + 1) / team->threads;
+    for (long width = 1; width < team->chunks; width *= 2) {
+        pthread_barrier_wait(&team->barrier);
+        pmergeRoundSlice(src, dst, bound, team->chunks, width, begin, end);
+        swap(src, dst);
+    }
+    return nullptr;
+}
+
+template <class T>
+void parallelMergeSort(T* a, long n, long threads) {
+    if (n < 2) return;
+    vector<T> scratch(n);
+
+    PMergeTeam<T> team;
+    team.a = a;
+    team.buf = scratch.data();
+    team.n = n;
+    team.chunks = max(1L, min(threads, n / PMERGE_MIN_CHUNK));
+    team.bound.resize(team.chunks + 1);
+    for (long i = 0; i <= team.chunks; i++) team.bound[i] = n * i / team.chunks;
+
+    long rounds = 0;
+    for (long width = 1; width < team.chunks; width *= 2) rounds++;
+    // After an odd number of rounds the runs must start out in the scratch
+    team.inScratch = rounds % 2 == 1;
+
+    // With a single chunk there are no rounds and one thread does everything
+    long teamSize = rounds == 0 ? 1 : threads;
+    team.threads = teamSize;
+    pthread_barrier_init(&team.barrier, nullptr, teamSize);
+    vector<pthread_t> workers(teamSize);
+    vector<PMergeThreadData<T>> threadData(teamSize);
+    for (long i = 0; i < teamSize; i++) {
+        threadData[i].threadNum = i;
+        threadData[i].team = &team;
+    }
+    // The calling thread works as thread 0
+    for (long i = 1; i < teamSize; i++) {
+        pthread_create(&workers[i], nullptr, pmergeWorker<T>, &threadData[i]);
+    }
+    pmergeWorker<T>(&threadData[0]);
+    for (long i = 1; i < teamSize; i++) {
+        pthread_join(workers[i], nullptr);
+    }
+    pthread_barrier_destroy(&team.barrier);
+}
+
+template <class T>
+void parallelMergeSort(vector<T>& arr, long threads) {
+    parallelMergeSort(arr.data(), (long)arr.size(), threads);
+}
+
+#endif // PARALLEL_MERGE_H
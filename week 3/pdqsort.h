@@ -0,0 +1,431 @@
+/*
+    Altered version of pdqsort.h - Pattern-defeating quicksort.
+    Changes: ported to raw pointers and this repo's naming, C++11 only,
+    and an up-front scan that finishes fully ascending or descending input.
+
+    Copyright (c) 2021 Orson Peters
+
+    This software is provided 'as-is', without any express or implied warranty. In no event will the
+    authors be held liable for any damages arising from the use of this software.
+
+    Permission is granted to anyone to use this software for any purpose, including commercial
+    applications, and to alter it and redistribute it freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not claim that you wrote the
+       original software. If you use this software in a product, an acknowledgment in the product
+       documentation would be appreciated but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be misrepresented as
+       being the original software.
+
+    3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef PDQSORT_H
+#define PDQSORT_H
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <cstddef>
+
+// Pattern-defeating quicksort (Orson Peters' pdqsort) with the BlockQuicksort
+// partition of Edelkamp and Weiss.
+//
+// For arithmetic keys under std::less/std::greater the partition does not
+// branch on comparisons: it scans a block of up to PDQ_BLOCK_SIZE elements
+// from each end, writes the offset of every element on the wrong side into a
+// small buffer (the offset is always written, the count only advances when
+// the comparison says so) and then swaps the misplaced pairs in one go. Other
+// types and comparators use the classic Hoare loop.
+//
+// On top of that:
+//   - a whole input that is already ascending or descending is detected in
+//     one scan and finished in O(n)
+//   - a partition that moved nothing is followed by a bounded insertion sort
+//     of both halves, so sorted stretches stay linear
+//   - a pivot equal to the element left of the range sends all equal keys to
+//     the left in one pass and never recurses into them
+//   - a badly unbalanced partition swaps a few elements around to break up
+//     adversarial patterns; after log2(n) of those the range is heapsorted
+
+const ptrdiff_t PDQ_INSERTION_SORT_THRESHOLD = 24;
+const ptrdiff_t PDQ_NINTHER_THRESHOLD = 128;
+const ptrdiff_t PDQ_PARTIAL_INSERTION_SORT_LIMIT = 8;
+const int PDQ_BLOCK_SIZE = 64;
+
+template <class T, class Compare>
+struct PdqBranchless {
+    static const bool value = false;
+};
+
+template <class T>
+struct PdqBranchless<T, std::less<T>> {
+    static const bool value = std::is_arithmetic<T>::value;
+};
+
+template <class T>
+struct PdqBranchless<T, std::greater<T>> {
+    static const bool value = std::is_arithmetic<T>::value;
+};
+
+template <class T, class Compare>
+void pdqInsertionSort(T* begin, T* end, Compare comp) {
+    if (begin == end) return;
+    for (T* cur = begin + 1; cur != end; ++cur) {
+        T* sift = cur;
+        T* sift1 = cur - 1;
+        if (comp(*sift, *sift1)) {
+            T tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift1);
+            } while (sift != begin && comp(tmp, *--sift1));
+            *sift = std::move(tmp);
+        }
+    }
+}
+
+// Requires an element left of begin that is not greater than anything in the
+// range, which stops the inner loop without a bounds check
+template <class T, class Compare>
+void pdqUnguardedInsertionSort(T* begin, T* end, Compare comp) {
+    if (begin == end) return;
+    for (T* cur = begin + 1; cur != end; ++cur) {
+        T* sift = cur;
+        T* sift1 = cur - 1;
+        if (comp(*sift, *sift1)) {
+            T tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift1);
+            } while (comp(tmp, *--sift1));
+            *sift = std::move(tmp);
+        }
+    }
+}
+
+// Insertion sort that gives up once more than PDQ_PARTIAL_INSERTION_SORT_LIMIT
+// elements have been moved; returns whether the range ended up sorted
+template <class T, class Compare>
+bool pdqPartialInsertionSort(T* begin, T* end, Compare comp) {
+    if (begin == end) return true;
+    ptrdiff_t moved = 0;
+    for (T* cur = begin + 1; cur != end; ++cur) {
+        T* sift = cur;
+        T* sift1 = cur - 1;
+        if (comp(*sift, *sift1)) {
+            T tmp = std::move(*sift);
+            do {
+                *sift-- = std::move(*sift1);
+            } while (sift != begin && comp(tmp, *--sift1));
+            *sift = std::move(tmp);
+            moved += cur - sift;
+        }
+        if (moved > PDQ_PARTIAL_INSERTION_SORT_LIMIT) return false;
+    }
+    return true;
+}
+
+template <class T, class Compare>
+void pdqSort2(T* a, T* b, Compare comp) {
+    if (comp(*b, *a)) std::iter_swap(a, b);
+}
+
+template <class T, class Compare>
+void pdqSort3(T* a, T* b, T* c, Compare comp) {
+    pdqSort2(a, b, comp);
+    pdqSort2(b, c, comp);
+    pdqSort2(a, b, comp);
+}
+
+// Swaps first[offsetsL[i]] with last[-offsetsR[i]] for i < num. When the two
+// blocks hold the same count the plain swaps are kept, otherwise one cyclic
+// permutation does it with fewer moves.
+template <class T>
+void pdqSwapOffsets(T* first, T* last, const unsigned char* offsetsL, const unsigned char* offsetsR,
+                    size_t num, bool useSwaps) {
+    if (useSwaps) {
+        for (size_t i = 0; i < num; i++) {
+            std::iter_swap(first + offsetsL[i], last - offsetsR[i]);
+        }
+    } else if (num > 0) {
+        T* l = first + offsetsL[0];
+        T* r = last - offsetsR[0];
+        T tmp(std::move(*l));
+        *l = std::move(*r);
+        for (size_t i = 1; i < num; i++) {
+            l = first + offsetsL[i];
+            *r = std::move(*l);
+            r = last - offsetsR[i];
+            *l = std::move(*r);
+        }
+        *r = std::move(tmp);
+    }
+}
+
+// Partitions [begin, end) around *begin into [< pivot] pivot [>= pivot].
+// Returns the pivot position and whether no element had to move.
+template <class T, class Compare>
+std::pair<T*, bool> pdqPartitionRightBranchless(T* begin, T* end, Compare comp) {
+    T pivot(std::move(*begin));
+    T* first = begin;
+    T* last = end;
+
+    // The pivot is a median of three or more, so there is an element >= pivot
+    // on the right and, unless first did not move, one < pivot on the left
+    while (comp(*++first, pivot)) {}
+    if (first - 1 == begin) {
+        while (first < last && !comp(*--last, pivot)) {}
+    } else {
+        while (!comp(*--last, pivot)) {}
+    }
+
+    bool alreadyPartitioned = first >= last;
+    if (!alreadyPartitioned) {
+        std::iter_swap(first, last);
+        ++first;
+
+        unsigned char offsetsL[PDQ_BLOCK_SIZE];
+        unsigned char offsetsR[PDQ_BLOCK_SIZE];
+        T* offsetsLBase = first;
+        T* offsetsRBase = last;
+        size_t numL = 0, numR = 0, startL = 0, startR = 0;
+
+        while (first < last) {
+            // Refill whichever block ran empty; split what is left when both did
+            size_t numUnknown = last - first;
+            size_t leftSplit = numL == 0 ? (numR == 0 ? numUnknown / 2 : numUnknown) : 0;
+            size_t rightSplit = numR == 0 ? (numUnknown - leftSplit) : 0;
+
+            if (leftSplit >= (size_t)PDQ_BLOCK_SIZE) {
+                for (int i = 0; i < PDQ_BLOCK_SIZE; i++) {
+                    offsetsL[numL] = (unsigned char)i;
+                    numL += !comp(*first, pivot);
+                    ++first;
+                }
+            } else {
+                for (size_t i = 0; i < leftSplit; i++) {
+                    offsetsL[numL] = (unsigned char)i;
+                    numL += !comp(*first, pivot);
+                    ++first;
+                }
+            }
+
+            if (rightSplit >= (size_t)PDQ_BLOCK_SIZE) {
+                for (int i = 1; i <= PDQ_BLOCK_SIZE; i++) {
+                    offsetsR[numR] = (unsigned char)i;
+                    numR += comp(*--last, pivot);
+                }
+            } else {
+                for (size_t i = 1; i <= rightSplit; i++) {
+                    offsetsR[numR] = (unsigned char)i;
+                    numR += comp(*--last, pivot);
+                }
+            }
+
+            size_t num = std::min(numL, numR);
+            pdqSwapOffsets(offsetsLBase, offsetsRBase, offsetsL + startL, offsetsR + startR, num, numL == numR);
+            numL -= num;
+            numR -= num;
+            startL += num;
+            startR += num;
+
+            if (numL == 0) {
+                startL = 0;
+                offsetsLBase = first;
+            }
+            if (numR == 0) {
+                startR = 0;
+                offsetsRBase = last;
+            }
+        }
+
+        // At most one block still holds misplaced elements; move them to the
+        // boundary
+        if (numL) {
+            while (numL--) std::iter_swap(offsetsLBase + offsetsL[startL + numL], --last);
+            first = last;
+        }
+        if (numR) {
+            while (numR--) std::iter_swap(offsetsRBase - offsetsR[startR + numR], first++);
+            last = first;
+        }
+    }
+
+    T* pivotPos = first - 1;
+    *begin = std::move(*pivotPos);
+    *pivotPos = std::move(pivot);
+    return std::make_pair(pivotPos, alreadyPartitioned);
+}
+
+// Same contract as pdqPartitionRightBranchless, one comparison branch at a time
+template <class T, class Compare>
+std::pair<T*, bool> pdqPartitionRight(T* begin, T* end, Compare comp) {
+    T pivot(std::move(*begin));
+    T* first = begin;
+    T* last = end;
+
+    while (comp(*++first, pivot)) {}
+    if (first - 1 == begin) {
+        while (first < last && !comp(*--last, pivot)) {}
+    } else {
+        while (!comp(*--last, pivot)) {}
+    }
+
+    bool alreadyPartitioned = first >= last;
+    while (first < last) {
+        std::iter_swap(first, last);
+        while (comp(*++first, pivot)) {}
+        while (!comp(*--last, pivot)) {}
+    }
+
+    T* pivotPos = first - 1;
+    *begin = std::move(*pivotPos);
+    *pivotPos = std::move(pivot);
+    return std::make_pair(pivotPos, alreadyPartitioned);
+}
+
+// Partitions into [<= pivot] pivot [> pivot]. Used when the pivot equals the
+// element left of the range: everything equal to it lands left of the returned
+// position and is already in its final place.
+template <class T, class Compare>
+T* pdqPartitionLeft(T* begin, T* end, Compare comp) {
+    T pivot(std::move(*begin));
+    T* first = begin;
+    T* last = end;
+
+    while (comp(pivot, *--last)) {}
+    if (last + 1 == end) {
+        while (first < last && !comp(pivot, *++first)) {}
+    } else {
+        while (!comp(pivot, *++first)) {}
+    }
+
+    while (first < last) {
+        std::iter_swap(first, last);
+        while (comp(pivot, *--last)) {}
+        while (!comp(pivot, *++first)) {}
+    }
+
+    T* pivotPos = last;
+    *begin = std::move(*pivotPos);
+    *pivotPos = std::move(pivot);
+    return pivotPos;
+}
+
+template <bool Branchless, class T, class Compare>
+void pdqSortLoop(T* begin, T* end, Compare comp, int badAllowed, bool leftmost) {
+    while (true) {
+        ptrdiff_t size = end - begin;
+        if (size < PDQ_INSERTION_SORT_THRESHOLD) {
+            if (leftmost) {
+                pdqInsertionSort(begin, end, comp);
+            } else {
+                pdqUnguardedInsertionSort(begin, end, comp);
+            }
+            return;
+        }
+
+        // Pivot to *begin: Tukey's ninther for large ranges, else median of 3
+        ptrdiff_t half = size / 2;
+        if (size > PDQ_NINTHER_THRESHOLD) {
+            pdqSort3(begin, begin + half, end - 1, comp);
+            pdqSort3(begin + 1, begin + (half - 1), end - 2, comp);
+            pdqSort3(begin + 2, begin + (half + 1), end - 3, comp);
+            pdqSort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+            std::iter_swap(begin, begin + half);
+        } else {
+            pdqSort3(begin + half, begin, end - 1, comp);
+        }
+
+        if (!leftmost && !comp(*(begin - 1), *begin)) {
+            begin = pdqPartitionLeft(begin, end, comp) + 1;
+            continue;
+        }
+
+        std::pair<T*, bool> part = Branchless ? pdqPartitionRightBranchless(begin, end, comp)
+                                              : pdqPartitionRight(begin, end, comp);
+        T* pivotPos = part.first;
+        bool alreadyPartitioned = part.second;
+
+        ptrdiff_t leftSize = pivotPos - begin;
+        ptrdiff_t rightSize = end - (pivotPos + 1);
+        bool highlyUnbalanced = leftSize < size / 8 || rightSize < size / 8;
+
+        if (highlyUnbalanced) {
+            if (--badAllowed == 0) {
+                std::make_heap(begin, end, comp);
+                std::sort_heap(begin, end, comp);
+                return;
+            }
+
+            // Break the pattern that made the pivot bad
+            if (leftSize >= PDQ_INSERTION_SORT_THRESHOLD) {
+                std::iter_swap(begin, begin + leftSize / 4);
+                std::iter_swap(pivotPos - 1, pivotPos - leftSize / 4);
+                if (leftSize > PDQ_NINTHER_THRESHOLD) {
+                    std::iter_swap(begin + 1, begin + (leftSize / 4 + 1));
+                    std::iter_swap(begin + 2, begin + (leftSize / 4 + 2));
+                    std::iter_swap(pivotPos - 2, pivotPos - (leftSize / 4 + 1));
+                    std::iter_swap(pivotPos - 3, pivotPos - (leftSize / 4 + 2));
+                }
+            }
+            if (rightSize >= PDQ_INSERTION_SORT_THRESHOLD) {
+                std::iter_swap(pivotPos + 1, pivotPos + (1 + rightSize / 4));
+                std::iter_swap(end - 1, end - rightSize / 4);
+                if (rightSize > PDQ_NINTHER_THRESHOLD) {
+                    std::iter_swap(pivotPos + 2, pivotPos + (2 + rightSize / 4));
+                    std::iter_swap(pivotPos + 3, pivotPos + (3 + rightSize / 4));
+                    std::iter_swap(end - 2, end - (1 + rightSize / 4));
+                    std::iter_swap(end - 3, end - (2 + rightSize / 4));
+                }
+            }
+        } else if (alreadyPartitioned && pdqPartialInsertionSort(begin, pivotPos, comp) &&
+                   pdqPartialInsertionSort(pivotPos + 1, end, comp)) {
+            return;
+        }
+
+        pdqSortLoop<Branchless>(begin, pivotPos, comp, badAllowed, leftmost);
+        begin = pivotPos + 1;
+        leftmost = false;
+    }
+}
+
+// One scan for a fully ascending or strictly descending input, which is left
+// sorted; returns false for anything else
+template <class T, class Compare>
+bool pdqSortMonotonic(T* begin, T* end, Compare comp) {
+    if (end - begin < 2) return true;
+    T* run = begin + 1;
+    if (comp(*run, *begin)) {
+        while (run != end && comp(*run, *(run - 1))) ++run;
+        if (run != end) return false;
+        std::reverse(begin, end);
+        return true;
+    }
+    while (run != end && !comp(*run, *(run - 1))) ++run;
+    return run == end;
+}
+
+template <class T, class Compare>
+void pdqSort(T* begin, T* end, Compare comp) {
+    if (pdqSortMonotonic(begin, end, comp)) return;
+
+    ptrdiff_t size = end - begin;
+    int badAllowed = 0;
+    for (ptrdiff_t k = size; k > 1; k >>= 1) badAllowed++;
+    pdqSortLoop<PdqBranchless<T, Compare>::value>(begin, end, comp, badAllowed, true);
+}
+
+template <class T>
+void pdqSort(T* begin, T* end) {
+    pdqSort(begin, end, std::less<T>());
+}
+
+template <class T>
+void pdqSort(std::vector<T>& arr) {
+    pdqSort(arr.data(), arr.data() + arr.size(), std::less<T>());
+}
+
+#endif // PDQSORT_H
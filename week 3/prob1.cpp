@@ -6,6 +6,8 @@
 
 #include<ctime>
 
+#include "introsort.h"
+
 using namespace std;
 
 void bubbleSort(vector < int > & a) {
@@ -143,6 +145,9 @@ int main(int argc, char * argv[]) {
     #elif HEAP
     cout << "using heap sort\n";
     heapSort(temp);
+    #elif INTRO
+    cout << "using introsort\n";
+    introSort(temp);
     #else
     cout << "No algo defined\n";
     return 1;
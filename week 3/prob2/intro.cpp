@@ -0,0 +1,12 @@
+#include <bits/stdc++.h>
+#include "../introsort.h"
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int n = stoi(argv[1]);
+    srand(time(NULL));
+    vector<int> arr(n);
+    for (int i = 0; i < n; i++) arr[i] = rand();
+    introSort(arr);
+    return 0;
+}
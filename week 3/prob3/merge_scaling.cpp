@@ -0,0 +1,86 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <sys/stat.h>
+#include "../parallel_merge.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// Times parallelMergeSort on the same random input for every thread count
+// from the core count down to 1, and reports the speedup over one thread
+
+double runPerformanceTest(const vector<int>& input, long numThreads) {
+    vector<int> data(input);
+    auto startTime = high_resolution_clock::now();
+    parallelMergeSort(data, numThreads);
+    auto endTime = high_resolution_clock::now();
+    auto duration = duration_cast<microseconds>(endTime - startTime);
+
+    bool isValid = is_sorted(data.begin(), data.end());
+    return isValid ? (duration.count() / 1000.0) : -1;
+}
+
+int main(int argc, char* argv[]) {
+    long numElements = (argc >= 2) ? atol(argv[1]) : 10000000;
+    mkdir("results", 0777);
+
+    long coreCount = thread::hardware_concurrency();
+    if (coreCount == 0) coreCount = 8;
+    if (argc >= 3) coreCount = atol(argv[2]);
+
+    cout << "Found " << coreCount << " CPU cores" << endl;
+    cout << endl;
+
+    srand(time(nullptr));
+    vector<int> input(numElements);
+    for (long i = 0; i < numElements; i++) input[i] = rand();
+
+    vector<long> threadCounts;
+    for (long m = coreCount; m >= 1; m--) threadCounts.push_back(m);
+    vector<double> times(threadCounts.size(), -1);
+
+    cout << "Sorting " << numElements << " numbers..." << endl;
+    cout << "Threads\tTime(ms)\tSpeedup" << endl;
+    cout << "------\t--------\t-------" << endl;
+
+    // One thread first, so every row can print its speedup
+    double baseTime = 0;
+    for (long k = threadCounts.size(); k-- > 0;) {
+        double totalTime = 0;
+        long validCount = 0;
+
+        long run = 3;
+        while (run-- > 0) {
+            double time = runPerformanceTest(input, threadCounts[k]);
+            if (time > 0) {
+                totalTime += time;
+                validCount++;
+            }
+        }
+
+        if (validCount > 0) {
+            times[k] = totalTime / validCount;
+            if (threadCounts[k] == 1) baseTime = times[k];
+            cout << threadCounts[k] << "\t" << fixed << setprecision(2) << times[k]
+                 << "\t\t" << setprecision(2) << baseTime / times[k] << "x" << endl;
+        }
+    }
+
+    ofstream scalingStream("results/merge_thread_scaling.csv");
+    scalingStream << "N,M,Time_ms,Speedup" << endl;
+    for (size_t k = 0; k < threadCounts.size(); k++) {
+        if (times[k] < 0) continue;
+        scalingStream << numElements << "," << threadCounts[k] << "," << fixed << setprecision(3) << times[k]
+                      << "," << setprecision(3) << baseTime / times[k] << endl;
+    }
+    scalingStream.close();
+
+    return 0;
+}
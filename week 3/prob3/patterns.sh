@@ -0,0 +1,39 @@
+#!/bin/bash
+
+echo "Comparing quicksort variants across input patterns..."
+
+# Settings
+size=${SIZE:-20000}
+patterns=(random sorted reverse organpipe fewunique)
+algorithms=(quick rquick std intro pdq simd)
+runs=10
+
+mkdir -p results
+
+echo "Pattern Quick RQuick Std Intro Pdq Simd" > results/pattern_data.txt
+
+for pattern in "${patterns[@]}"; do
+    echo "Testing pattern: $pattern"
+    
+    time_line="$pattern"
+    
+    for algo in "${algorithms[@]}"; do
+        total_time=0
+        
+        for ((i=1; i<=runs; i++)); do
+            output=$(./sorting_test $algo $size $pattern)
+            time=$(echo "$output" | grep "Time:" | cut -d' ' -f2)
+            
+            total_time=$(echo "$total_time + $time" | bc -l)
+        done
+        
+        avg_time=$(echo "scale=6; $total_time / $runs" | bc -l)
+        time_line="$time_line $avg_time"
+        
+        echo "  $algo: $avg_time seconds"
+    done
+    
+    echo "$time_line" >> results/pattern_data.txt
+done
+
+echo "Results written to results/pattern_data.txt"
@@ -9,4 +9,5 @@ plot 'results/memory_data.txt' using 1:2 with linespoints title 'Merge', \
      '' using 1:3 with linespoints title 'Quick', \
      '' using 1:4 with linespoints title 'Heap', \
      '' using 1:5 with linespoints title 'Bubble', \
-     '' using 1:6 with linespoints title 'Selection'
+     '' using 1:6 with linespoints title 'Selection', \
+     '' using 1:7 with linespoints title 'Intro'
@@ -4,13 +4,13 @@ echo "Starting sorting algorithm analysis..."
 
 # Settings
 sizes=(1000 5000 10000 15000 20000 30000)
-algorithms=(merge quick heap bubble selection)
+algorithms=(merge quick heap bubble selection intro)
 runs=20
 
 mkdir -p results
 
-echo "Size Merge Quick Heap Bubble Selection" > results/time_data.txt
-echo "Size Merge Quick Heap Bubble Selection" > results/memory_data.txt
+echo "Size Merge Quick Heap Bubble Selection Intro" > results/time_data.txt
+echo "Size Merge Quick Heap Bubble Selection Intro" > results/memory_data.txt
 
 for size in "${sizes[@]}"; do
     echo "Testing size: $size"
@@ -62,7 +62,8 @@ plot 'results/time_data.txt' using 1:2 with linespoints title 'Merge', \
      '' using 1:3 with linespoints title 'Quick', \
      '' using 1:4 with linespoints title 'Heap', \
      '' using 1:5 with linespoints title 'Bubble', \
-     '' using 1:6 with linespoints title 'Selection'
+     '' using 1:6 with linespoints title 'Selection', \
+     '' using 1:7 with linespoints title 'Intro'
 EOF
 
 cat > plot_memory.gnu << 'EOF'
@@ -77,7 +78,8 @@ plot 'results/memory_data.txt' using 1:2 with linespoints title 'Merge', \
      '' using 1:3 with linespoints title 'Quick', \
      '' using 1:4 with linespoints title 'Heap', \
      '' using 1:5 with linespoints title 'Bubble', \
-     '' using 1:6 with linespoints title 'Selection'
+     '' using 1:6 with linespoints title 'Selection', \
+     '' using 1:7 with linespoints title 'Intro'
 EOF
 
 echo "Scripts created! Run 'gnuplot plot_time.gnu' and 'gnuplot plot_memory.gnu' to create graphs."
\ No newline at end of file
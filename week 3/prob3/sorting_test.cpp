@@ -3,6 +3,13 @@
 #include <cstdlib>
 #include <ctime>
 #include <chrono>
+#include <string>
+#include <algorithm>
+#include <thread>
+#include "../introsort.h"
+#include "../pdqsort.h"
+#include "../simdsort.h"
+#include "../parallel_merge.h"
 
 using namespace std;
 using namespace std::chrono;
@@ -63,6 +70,21 @@ void quickSort(vector<int>& arr, int low, int high) {
     }
 }
 
+int randomizedPartition(vector<int>& arr, int low, int high) {
+    int randomIndex = low + rand() % (high - low + 1);
+    swap(arr[randomIndex], arr[high]);
+    return partition(arr, low, high);
+}
+
+void randomizedQuickSort(vector<int>& arr, int low, int high) {
+    if (low < high) {
+        total_memory_used += sizeof(int);
+        int pi = randomizedPartition(arr, low, high);
+        randomizedQuickSort(arr, low, pi - 1);
+        randomizedQuickSort(arr, pi + 1, high);
+    }
+}
+
 void heapify(vector<int>& arr, int n, int i) {
     int largest = i;
     int left = 2 * i + 1;
@@ -115,19 +137,34 @@ void selectionSort(vector<int>& arr) {
 }
 
 int main(int argc, char* argv[]) {
-    if (argc != 3) {
-        cout << "Usage: " << argv[0] << " <algorithm> <size>" << endl;
+    if (argc < 3 || argc > 5) {
+        cout << "Usage: " << argv[0] << " <algorithm> <size> [random|sorted|reverse|organpipe|fewunique] [threads]" << endl;
         return 1;
     }
     
     string algorithm = argv[1];
     int size = atoi(argv[2]);
+    string pattern = argc >= 4 ? argv[3] : "random";
+    long threads = argc == 5 ? atol(argv[4]) : thread::hardware_concurrency();
+    if (threads < 1) threads = 1;
     
     srand(time(NULL));
     vector<int> data(size);
     for (int i = 0; i < size; i++) {
         data[i] = rand() % 10000;
     }
+    if (pattern == "sorted") {
+        sort(data.begin(), data.end());
+    } else if (pattern == "reverse") {
+        sort(data.rbegin(), data.rend());
+    } else if (pattern == "organpipe") {
+        for (int i = 0; i < size; i++) data[i] = min(i, size - 1 - i);
+    } else if (pattern == "fewunique") {
+        for (int i = 0; i < size; i++) data[i] = rand() % 8;
+    } else if (pattern != "random") {
+        cout << "Unknown pattern: " << pattern << endl;
+        return 1;
+    }
     
     total_memory_used = 0;
     
@@ -145,6 +182,19 @@ int main(int argc, char* argv[]) {
         bubbleSort(data);
     } else if (algorithm == "selection") {
         selectionSort(data);
+    } else if (algorithm == "intro") {
+        introSort(data);
+    } else if (algorithm == "rquick") {
+        randomizedQuickSort(data, 0, size - 1);
+    } else if (algorithm == "pdq") {
+        pdqSort(data);
+    } else if (algorithm == "std") {
+        sort(data.begin(), data.end());
+    } else if (algorithm == "simd") {
+        simdSort(data);
+    } else if (algorithm == "pmerge") {
+        total_memory_used += size * sizeof(int);
+        parallelMergeSort(data, threads);
     }
     
     auto end = high_resolution_clock::now();
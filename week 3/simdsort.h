@@ -0,0 +1,362 @@
+#ifndef SIMDSORT_H
+#define SIMDSORT_H
+
+#include <vector>
+#include <climits>
+#include <algorithm>
+#include "pdqsort.h"
+
+// Vectorized quicksort for int32 keys.
+//
+//   partition   each vector is compared against the pivot in one instruction;
+//               the lanes <= pivot are packed to the left write cursor and the
+//               rest to the right one (a permutation looked up from the
+//               comparison mask on AVX2, compress stores on AVX-512). The first
+//               and last vector are held in registers, so the stores always
+//               land on space that has already been read.
+//   small sort  ranges of up to SIMD_SMALL_SORT keys are padded with INT_MAX,
+//               sorted 16 at a time by an in-register bitonic network and the
+//               16-key runs merged with a vectorized bitonic merge.
+//   duplicates  when every key is <= the pivot, the range is split once more
+//               at pivot - 1 and the keys equal to the pivot are done.
+//
+// An input that is already ascending or descending is caught by one scan
+// first. The instruction set is picked at runtime (AVX-512F, then AVX2).
+// Without either, or on other architectures, simdSort() is pdqSort(). Deep
+// recursion also hands the range to pdqSort, like introsort's heapsort
+// fallback.
+
+enum SimdSortLevel { SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512 };
+
+const long SIMD_SMALL_SORT = 64;
+
+inline const char* simdSortLevelName(SimdSortLevel level) {
+    switch (level) {
+    case SIMD_AVX512: return "avx512";
+    case SIMD_AVX2: return "avx2";
+    default: return "scalar";
+    }
+}
+
+inline int simdMedian3(int a, int b, int c) {
+    return std::max(std::min(a, b), std::min(std::max(a, b), c));
+}
+
+// Tukey's ninther of the values, read in place
+inline int simdPivot(const int* a, long n) {
+    long s = n / 8, mid = n / 2;
+    return simdMedian3(simdMedian3(a[0], a[s], a[2 * s]),
+                       simdMedian3(a[mid - s], a[mid], a[mid + s]),
+                       simdMedian3(a[n - 1 - 2 * s], a[n - 1 - s], a[n - 1]));
+}
+
+// Quicksort driver shared by the vector kernels. Kernel::partition(a, n, p)
+// moves the keys <= p to the front and returns how many there are;
+// Kernel::smallSort sorts at most SIMD_SMALL_SORT keys.
+template <class Kernel>
+void simdQuickSort(int* a, long n, int depthLimit) {
+    while (n > SIMD_SMALL_SORT) {
+        if (depthLimit-- == 0) {
+            pdqSort(a, a + n);
+            return;
+        }
+
+        int pivot = simdPivot(a, n);
+        long mid = Kernel::partition(a, n, pivot);
+        if (mid == n) {
+            // The pivot is the maximum; peel off its copies
+            if (pivot == INT_MIN) return;
+            n = Kernel::partition(a, n, pivot - 1);
+            continue;
+        }
+
+        if (mid < n - mid) {
+            simdQuickSort<Kernel>(a, mid, depthLimit);
+            a += mid;
+            n -= mid;
+        } else {
+            simdQuickSort<Kernel>(a + mid, n - mid, depthLimit);
+            n = mid;
+        }
+    }
+    Kernel::smallSort(a, n);
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMDSORT_X86 1
+#include <immintrin.h>
+
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx512f,avx2,popcnt")))
+
+// For each 8-bit "lane > pivot" mask, the lane order that puts the other
+// lanes first and these last, both groups in their original order
+struct SimdPartitionTable {
+    int perm[256][8];
+
+    SimdPartitionTable() {
+        for (int mask = 0; mask < 256; mask++) {
+            int k = 0;
+            for (int i = 0; i < 8; i++) {
+                if (!(mask >> i & 1)) perm[mask][k++] = i;
+            }
+            for (int i = 0; i < 8; i++) {
+                if (mask >> i & 1) perm[mask][k++] = i;
+            }
+        }
+    }
+};
+
+inline const SimdPartitionTable& simdPartitionTable() {
+    static const SimdPartitionTable table;
+    return table;
+}
+
+// One compare-exchange layer: each lane meets lane idx[i] and keeps the
+// maximum where the blend mask bit is set, the minimum elsewhere
+#define SIMD_CMPSWAP8(v, i0, i1, i2, i3, i4, i5, i6, i7, blend)                               \
+    do {                                                                                      \
+        __m256i other = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(i0, i1, i2, i3, i4, i5, i6, i7)); \
+        v = _mm256_blend_epi32(_mm256_min_epi32(v, other), _mm256_max_epi32(v, other), blend); \
+    } while (0)
+
+// Sorts the lanes of v with a bitonic network
+SIMD_TARGET_AVX2 inline __m256i simdSort8(__m256i v) {
+    SIMD_CMPSWAP8(v, 1, 0, 3, 2, 5, 4, 7, 6, 0x66);
+    SIMD_CMPSWAP8(v, 2, 3, 0, 1, 6, 7, 4, 5, 0x3c);
+    SIMD_CMPSWAP8(v, 1, 0, 3, 2, 5, 4, 7, 6, 0x5a);
+    SIMD_CMPSWAP8(v, 4, 5, 6, 7, 0, 1, 2, 3, 0xf0);
+    SIMD_CMPSWAP8(v, 2, 3, 0, 1, 6, 7, 4, 5, 0xcc);
+    SIMD_CMPSWAP8(v, 1, 0, 3, 2, 5, 4, 7, 6, 0xaa);
+    return v;
+}
+
+// Sorts a bitonic vector
+SIMD_TARGET_AVX2 inline __m256i simdBitonicMerge8(__m256i v) {
+    SIMD_CMPSWAP8(v, 4, 5, 6, 7, 0, 1, 2, 3, 0xf0);
+    SIMD_CMPSWAP8(v, 2, 3, 0, 1, 6, 7, 4, 5, 0xcc);
+    SIMD_CMPSWAP8(v, 1, 0, 3, 2, 5, 4, 7, 6, 0xaa);
+    return v;
+}
+
+#undef SIMD_CMPSWAP8
+
+// Merges two sorted vectors: lo gets the 8 smallest keys, hi the 8 largest
+SIMD_TARGET_AVX2 inline void simdMerge16(__m256i& lo, __m256i& hi) {
+    __m256i reversed = _mm256_permutevar8x32_epi32(hi, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    __m256i small = _mm256_min_epi32(lo, reversed);
+    __m256i large = _mm256_max_epi32(lo, reversed);
+    lo = simdBitonicMerge8(small);
+    hi = simdBitonicMerge8(large);
+}
+
+// Merges sorted runs a and b, both a multiple of 8 long, into out
+SIMD_TARGET_AVX2 inline void simdMergeRuns(const int* a, long lenA, const int* b, long lenB, int* out) {
+    __m256i lo = _mm256_loadu_si256((const __m256i*)a);
+    __m256i hi = _mm256_loadu_si256((const __m256i*)b);
+    long i = 8, j = 8;
+    while (true) {
+        simdMerge16(lo, hi);
+        _mm256_storeu_si256((__m256i*)out, lo);
+        out += 8;
+        if (i < lenA && (j >= lenB || a[i] <= b[j])) {
+            lo = _mm256_loadu_si256((const __m256i*)(a + i));
+            i += 8;
+        } else if (j < lenB) {
+            lo = _mm256_loadu_si256((const __m256i*)(b + j));
+            j += 8;
+        } else {
+            break;
+        }
+    }
+    _mm256_storeu_si256((__m256i*)out, hi);
+}
+
+SIMD_TARGET_AVX2 inline void simdSmallSortAvx2(int* a, long n) {
+    if (n < 2) return;
+    int buf[2][SIMD_SMALL_SORT];
+    long padded = 16;
+    while (padded < n) padded *= 2;
+    std::copy(a, a + n, buf[0]);
+    std::fill(buf[0] + n, buf[0] + padded, INT_MAX);
+
+    for (long i = 0; i < padded; i += 16) {
+        __m256i lo = simdSort8(_mm256_loadu_si256((const __m256i*)(buf[0] + i)));
+        __m256i hi = simdSort8(_mm256_loadu_si256((const __m256i*)(buf[0] + i + 8)));
+        simdMerge16(lo, hi);
+        _mm256_storeu_si256((__m256i*)(buf[0] + i), lo);
+        _mm256_storeu_si256((__m256i*)(buf[0] + i + 8), hi);
+    }
+
+    int cur = 0;
+    for (long width = 16; width < padded; width *= 2) {
+        for (long i = 0; i < padded; i += 2 * width) {
+            simdMergeRuns(buf[cur] + i, width, buf[cur] + i + width, width, buf[cur ^ 1] + i);
+        }
+        cur ^= 1;
+    }
+    std::copy(buf[cur], buf[cur] + n, a);
+}
+
+// Packs v into the two cursors: the lanes <= pivot at wl, the rest ending at
+// wr. Both stores write all 8 lanes; the caller guarantees 8 free slots at
+// each cursor (or exactly 8 shared ones, where the two stores coincide).
+SIMD_TARGET_AVX2 inline void simdPartitionVec8(__m256i v, __m256i pivot, const SimdPartitionTable& table,
+                                                int*& wl, int*& wr) {
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, pivot)));
+    __m256i perm = _mm256_loadu_si256((const __m256i*)table.perm[mask]);
+    __m256i packed = _mm256_permutevar8x32_epi32(v, perm);
+    int greater = _mm_popcnt_u32(mask);
+    _mm256_storeu_si256((__m256i*)wl, packed);
+    _mm256_storeu_si256((__m256i*)(wr - 8), packed);
+    wl += 8 - greater;
+    wr -= greater;
+}
+
+struct SimdAvx2Kernel {
+    // Requires n >= 16
+    SIMD_TARGET_AVX2 static long partition(int* a, long n, int pivotValue) {
+        const SimdPartitionTable& table = simdPartitionTable();
+        __m256i pivot = _mm256_set1_epi32(pivotValue);
+        __m256i first = _mm256_loadu_si256((const __m256i*)a);
+        __m256i last = _mm256_loadu_si256((const __m256i*)(a + n - 8));
+
+        // [l, r) is unread; [a, wl) and [wr, a + n) are done
+        int* l = a + 8;
+        int* r = a + n - 8;
+        int* wl = a;
+        int* wr = a + n;
+        while (r - l >= 8) {
+            // Read from the side with less free room, which keeps 8 free
+            // slots behind both cursors
+            __m256i v;
+            if (l - wl <= wr - r) {
+                v = _mm256_loadu_si256((const __m256i*)l);
+                l += 8;
+            } else {
+                r -= 8;
+                v = _mm256_loadu_si256((const __m256i*)r);
+            }
+            simdPartitionVec8(v, pivot, table, wl, wr);
+        }
+
+        int rest[8];
+        long restCount = r - l;
+        std::copy(l, r, rest);
+        for (long i = 0; i < restCount; i++) {
+            if (rest[i] <= pivotValue) {
+                *wl++ = rest[i];
+            } else {
+                *--wr = rest[i];
+            }
+        }
+
+        simdPartitionVec8(first, pivot, table, wl, wr);
+        simdPartitionVec8(last, pivot, table, wl, wr);
+        return wl - a;
+    }
+
+    static void smallSort(int* a, long n) { simdSmallSortAvx2(a, n); }
+};
+
+struct SimdAvx512Kernel {
+    // Same scheme as the AVX2 partition with 16 lanes and compress stores,
+    // which write only the selected lanes; requires n >= 32
+    SIMD_TARGET_AVX512 static long partition(int* a, long n, int pivotValue) {
+        __m512i pivot = _mm512_set1_epi32(pivotValue);
+        __m512i first = _mm512_loadu_si512((const void*)a);
+        __m512i last = _mm512_loadu_si512((const void*)(a + n - 16));
+
+        int* l = a + 16;
+        int* r = a + n - 16;
+        int* wl = a;
+        int* wr = a + n;
+        while (r - l >= 16) {
+            __m512i v;
+            if (l - wl <= wr - r) {
+                v = _mm512_loadu_si512((const void*)l);
+                l += 16;
+            } else {
+                r -= 16;
+                v = _mm512_loadu_si512((const void*)r);
+            }
+            packVec16(v, pivot, wl, wr);
+        }
+
+        int rest[16];
+        long restCount = r - l;
+        std::copy(l, r, rest);
+        for (long i = 0; i < restCount; i++) {
+            if (rest[i] <= pivotValue) {
+                *wl++ = rest[i];
+            } else {
+                *--wr = rest[i];
+            }
+        }
+
+        packVec16(first, pivot, wl, wr);
+        packVec16(last, pivot, wl, wr);
+        return wl - a;
+    }
+
+    static void smallSort(int* a, long n) { simdSmallSortAvx2(a, n); }
+
+private:
+    SIMD_TARGET_AVX512 static void packVec16(__m512i v, __m512i pivot, int*& wl, int*& wr) {
+        __mmask16 greater = _mm512_cmpgt_epi32_mask(v, pivot);
+        int count = _mm_popcnt_u32(greater);
+        _mm512_mask_compressstoreu_epi32(wl, (__mmask16)~greater, v);
+        _mm512_mask_compressstoreu_epi32(wr - count, greater, v);
+        wl += 16 - count;
+        wr -= count;
+    }
+};
+
+#undef SIMD_TARGET_AVX2
+#undef SIMD_TARGET_AVX512
+#endif // x86
+
+inline SimdSortLevel simdSortDetect() {
+#ifdef SIMDSORT_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SIMD_AVX512;
+    if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+#endif
+    return SIMD_SCALAR;
+}
+
+// The best level this CPU supports, probed once
+inline SimdSortLevel simdSortLevel() {
+    static const SimdSortLevel level = simdSortDetect();
+    return level;
+}
+
+// Sorts with the given level, which must be supported by the CPU
+inline void simdSort(int* a, long n, SimdSortLevel level) {
+    if (pdqSortMonotonic(a, a + n, std::less<int>())) return;
+    int depthLimit = 0;
+    for (long k = n; k > 1; k >>= 1) depthLimit += 2;
+#ifdef SIMDSORT_X86
+    if (level == SIMD_AVX512) {
+        simdQuickSort<SimdAvx512Kernel>(a, n, depthLimit);
+        return;
+    }
+    if (level == SIMD_AVX2) {
+        simdQuickSort<SimdAvx2Kernel>(a, n, depthLimit);
+        return;
+    }
+#endif
+    (void)depthLimit;
+    (void)level;
+    pdqSort(a, a + n);
+}
+
+inline void simdSort(int* a, long n) {
+    simdSort(a, n, simdSortLevel());
+}
+
+inline void simdSort(std::vector<int>& arr) {
+    simdSort(arr.data(), (long)arr.size());
+}
+
+#endif // SIMDSORT_H
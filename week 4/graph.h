@@ -8,7 +8,18 @@
 #include <algorithm>
 #include <iostream>
 #include <random>
-#include <set>
+#include <cstdint>
+#include <cmath>
+#include <string>
+#include <memory>
+#include <limits>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "parallel.h"
 using namespace std;
 
 struct Edge {
@@ -17,6 +28,123 @@ struct Edge {
     Edge(int t, int w = 1) : to(t), weight(w) {}
 };
 
+// SplitMix64: small, fast, seedable PRNG for the graph generators
+struct SplitMix64 {
+    uint64_t state;
+    explicit SplitMix64(uint64_t s) : state(s) {}
+    
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    
+    // Uniform in [0, bound) by multiply-shift
+    uint64_t below(uint64_t bound) { return (uint64_t)(((unsigned __int128)next() * bound) >> 64); }
+    
+    // Uniform in [0, 1)
+    double unit() { return (next() >> 11) * 0x1.0p-53; }
+};
+
+// Random work is cut into blocks of GEN_BLOCK draws, each with its own stream
+// derived from (seed, phase, block), so any thread count gives the same graph
+const uint64_t GEN_BLOCK = 1 << 16;
+const uint64_t GEN_PHASE_TRIM = 0xFFFF0001ULL;
+const uint64_t GEN_PHASE_WEIGHT = 0xFFFF0002ULL;
+const uint64_t GEN_PHASE_FAMILY = 0xFFFF0003ULL;
+const uint64_t GEN_PHASE_PERMUTE = 0xFFFF0004ULL;
+const uint64_t GEN_PHASE_ORIENT = 0xFFFF0005ULL;
+
+// Directed structured families: chance that an edge is kept in both directions
+const double GEN_BOTH_WAYS_PROB = 0.25;
+
+// R-MAT quadrant probabilities (Graph500 defaults); d = 1 - a - b - c
+const double RMAT_A = 0.57;
+const double RMAT_B = 0.19;
+const double RMAT_C = 0.19;
+
+inline SplitMix64 blockStream(uint64_t seed, uint64_t phase, uint64_t block) {
+    SplitMix64 mix(seed);
+    uint64_t key = mix.next() ^ (phase * 0xD1B54A32D192ED03ULL);
+    key = SplitMix64(key).next() ^ (block * 0x9E3779B97F4A7C15ULL);
+    return SplitMix64(SplitMix64(key).next());
+}
+
+// Maps indices of the possible (u, v) pairs, taken in increasing order, back to
+// the pairs by walking rows: row u holds (u, u+1 .. n-1) for undirected graphs and
+// (u, every v != u) for directed ones
+struct PairDecoder {
+    int n;
+    bool directed;
+    int u;
+    uint64_t rowStart;
+    
+    PairDecoder(int nodes, bool dir) : n(nodes), directed(dir), u(0), rowStart(0) {}
+    
+    uint64_t rowLength() const { return directed ? n - 1 : n - 1 - u; }
+    
+    void decode(uint64_t k, int& from, int& to) {
+        while (k >= rowStart + rowLength()) {
+            rowStart += rowLength();
+            u++;
+        }
+        int r = k - rowStart;
+        from = u;
+        to = directed ? (r < u ? r : r + 1) : u + 1 + r;
+    }
+};
+
+// Contiguous view over one vertex's edges, either in adj or in the CSR arrays
+struct EdgeRange {
+    const Edge* first;
+    const Edge* last;
+    const Edge* begin() const { return first; }
+    const Edge* end() const { return last; }
+    size_t size() const { return last - first; }
+    const Edge& operator[](size_t i) const { return first[i]; }
+};
+
+// On-disk CSR file, version 1. The header is followed by four sections at the
+// byte positions it records, each 64-byte aligned:
+//   offsets      (n + 1) x int32
+//   edges        edgeCount x {int32 to, int32 weight}
+//   rev_offsets  (n + 1) x int32   directed graphs only
+//   rev_edges    revEdgeCount x {int32 to, int32 weight}
+// Numbers are stored in host byte order.
+const char GRAPH_FILE_MAGIC[8] = {'I', 'I', 'T', 'R', 'C', 'S', 'R', '\0'};
+const uint32_t GRAPH_FILE_VERSION = 1;
+const uint32_t GRAPH_FILE_DIRECTED = 1;
+
+struct GraphFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t n;
+    uint64_t m;
+    uint64_t edgeCount;
+    uint64_t revEdgeCount;
+    uint64_t offsetsPos;
+    uint64_t edgesPos;
+    uint64_t revOffsetsPos;
+    uint64_t revEdgesPos;
+};
+
+// Read-only mapping of a graph file; unmapped when the last Graph using it goes away
+struct MappedGraphFile {
+    void* base;
+    size_t length;
+    const int* offsets;
+    const Edge* edges;
+    const int* revOffsets;
+    const Edge* revEdges;
+    
+    MappedGraphFile() : base(MAP_FAILED), length(0), offsets(nullptr), edges(nullptr), revOffsets(nullptr), revEdges(nullptr) {}
+    ~MappedGraphFile() {
+        if (base != MAP_FAILED) munmap(base, length);
+    }
+};
+
 class Graph {
 public:
     int n; // number of nodes
@@ -25,13 +153,133 @@ public:
     vector<vector<Edge>> adj_rev; // reverse adjacency list for directed graphs
     bool directed;
     
-    Graph(int nodes, bool dir = false) : n(nodes), m(0), directed(dir) {
+    // Frozen CSR form: edges of u are edges[offsets[u] .. offsets[u+1])
+    bool frozen;
+    vector<int> offsets;
+    vector<Edge> edges;
+    vector<int> rev_offsets; // reverse CSR, only for directed graphs
+    vector<Edge> rev_edges;
+    shared_ptr<MappedGraphFile> mapping; // set when the CSR arrays live in an mmap'd file
+    
+    Graph(int nodes, bool dir = false) : n(nodes), m(0), directed(dir), frozen(false) {
         adj.resize(n);
         if (directed) {
             adj_rev.resize(n);
         }
     }
     
+    EdgeRange out(int u) const {
+        if (mapping) return {mapping->edges + mapping->offsets[u], mapping->edges + mapping->offsets[u + 1]};
+        if (frozen) return {edges.data() + offsets[u], edges.data() + offsets[u + 1]};
+        return {adj[u].data(), adj[u].data() + adj[u].size()};
+    }
+    
+    // Incoming edges; for undirected graphs these are the outgoing ones
+    EdgeRange in(int u) const {
+        if (!directed) return out(u);
+        if (mapping) return {mapping->revEdges + mapping->revOffsets[u], mapping->revEdges + mapping->revOffsets[u + 1]};
+        if (frozen) return {rev_edges.data() + rev_offsets[u], rev_edges.data() + rev_offsets[u + 1]};
+        return {adj_rev[u].data(), adj_rev[u].data() + adj_rev[u].size()};
+    }
+    
+    // Write the frozen graph in the binary CSR format. Returns false on I/O errors.
+    bool saveBinary(const string& path) {
+        freeze();
+        const int* off = mapping ? mapping->offsets : offsets.data();
+        const Edge* out_edges = mapping ? mapping->edges : edges.data();
+        const int* roff = mapping ? mapping->revOffsets : rev_offsets.data();
+        const Edge* rev = mapping ? mapping->revEdges : rev_edges.data();
+        
+        GraphFileHeader h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, GRAPH_FILE_MAGIC, sizeof(h.magic));
+        h.version = GRAPH_FILE_VERSION;
+        h.flags = directed ? GRAPH_FILE_DIRECTED : 0;
+        h.n = n;
+        h.m = m;
+        h.edgeCount = off[n];
+        h.revEdgeCount = directed ? roff[n] : 0;
+        h.offsetsPos = alignFilePos(sizeof(h));
+        h.edgesPos = alignFilePos(h.offsetsPos + (h.n + 1) * sizeof(int));
+        h.revOffsetsPos = alignFilePos(h.edgesPos + h.edgeCount * sizeof(Edge));
+        h.revEdgesPos = alignFilePos(h.revOffsetsPos + (directed ? (h.n + 1) * sizeof(int) : 0));
+        
+        FILE* f = fopen(path.c_str(), "wb");
+        if (!f) return false;
+        bool ok = writeAt(f, 0, &h, sizeof(h)) &&
+                  writeAt(f, h.offsetsPos, off, (h.n + 1) * sizeof(int)) &&
+                  writeAt(f, h.edgesPos, out_edges, h.edgeCount * sizeof(Edge));
+        if (ok && directed) {
+            ok = writeAt(f, h.revOffsetsPos, roff, (h.n + 1) * sizeof(int)) &&
+                 writeAt(f, h.revEdgesPos, rev, h.revEdgeCount * sizeof(Edge));
+        }
+        return fclose(f) == 0 && ok;
+    }
+    
+    // Map a binary CSR file read-only; traversals then read the mapped pages
+    // directly and nothing is copied. The CSR arrays are checked once, in one
+    // pass, so a corrupt file cannot lead out() or in() out of bounds. Returns
+    // false and leaves g untouched if the file is missing, truncated, not a
+    // version 1 graph file or inconsistent.
+    static bool loadBinary(const string& path, Graph& g) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(GraphFileHeader)) {
+            close(fd);
+            return false;
+        }
+        
+        shared_ptr<MappedGraphFile> file = make_shared<MappedGraphFile>();
+        file->length = st.st_size;
+        file->base = mmap(nullptr, file->length, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (file->base == MAP_FAILED) return false;
+        
+        const char* bytes = (const char*)file->base;
+        GraphFileHeader h;
+        memcpy(&h, bytes, sizeof(h));
+        bool dir = h.flags & GRAPH_FILE_DIRECTED;
+        const uint64_t maxInt = numeric_limits<int>::max();
+        if (memcmp(h.magic, GRAPH_FILE_MAGIC, sizeof(h.magic)) != 0 || h.version != GRAPH_FILE_VERSION ||
+            h.n >= maxInt || h.m > maxInt || h.edgeCount > maxInt || h.revEdgeCount > maxInt ||
+            !sectionFits(h.offsetsPos, h.n + 1, sizeof(int), file->length) ||
+            !sectionFits(h.edgesPos, h.edgeCount, sizeof(Edge), file->length) ||
+            (dir && (!sectionFits(h.revOffsetsPos, h.n + 1, sizeof(int), file->length) ||
+                     !sectionFits(h.revEdgesPos, h.revEdgeCount, sizeof(Edge), file->length)))) {
+            return false;
+        }
+        madvise(file->base, file->length, MADV_WILLNEED);
+        
+        file->offsets = (const int*)(bytes + h.offsetsPos);
+        file->edges = (const Edge*)(bytes + h.edgesPos);
+        if (!validCSR(file->offsets, file->edges, h.n, h.edgeCount)) return false;
+        if (dir) {
+            file->revOffsets = (const int*)(bytes + h.revOffsetsPos);
+            file->revEdges = (const Edge*)(bytes + h.revEdgesPos);
+            if (!validCSR(file->revOffsets, file->revEdges, h.n, h.revEdgeCount)) return false;
+        }
+        
+        Graph loaded(0, dir);
+        loaded.n = h.n;
+        loaded.m = h.m;
+        loaded.frozen = true;
+        loaded.mapping = file;
+        g = move(loaded);
+        return true;
+    }
+    
+    // Pack the adjacency lists into CSR arrays and release the per-vertex vectors.
+    // No edges can be added afterwards.
+    void freeze() {
+        if (frozen) return;
+        packCSR(adj, offsets, edges);
+        if (directed) {
+            packCSR(adj_rev, rev_offsets, rev_edges);
+        }
+        frozen = true;
+    }
+    
     void addEdge(int u, int v, int weight = 1) {
         adj[u].push_back(Edge(v, weight));
         if (!directed) {
@@ -43,64 +291,457 @@ public:
         }
     }
     
-    // Generate random graph with n nodes and m edges
-    static Graph generateRandomGraph(int nodes, int edges, bool directed = false, int maxWeight = 1, unsigned seed = 0) {
-        if (seed == 0) {
-            seed = time(NULL);
-        }
-        srand(seed);
-        
+    // Build a frozen graph straight from an edge list, without going through adj.
+    // For undirected graphs every edge is stored in both directions.
+    static Graph fromEdgeList(int nodes, bool directed, const vector<int>& from, const vector<int>& to, const vector<int>& weight) {
         Graph g(nodes, directed);
-        int maxPossibleEdges = directed ? nodes * (nodes - 1) : nodes * (nodes - 1) / 2;
-        edges = std::min(edges, maxPossibleEdges);
+        vector<vector<Edge>>().swap(g.adj);
+        vector<vector<Edge>>().swap(g.adj_rev);
+        g.m = from.size();
         
-        set<pair<int, int>> usedEdges;
+        g.offsets.assign(nodes + 1, 0);
+        for (size_t i = 0; i < from.size(); i++) {
+            g.offsets[from[i] + 1]++;
+            if (!directed) g.offsets[to[i] + 1]++;
+        }
+        for (int u = 0; u < nodes; u++) {
+            g.offsets[u + 1] += g.offsets[u];
+        }
+        g.edges.assign(g.offsets[nodes], Edge(0));
+        vector<int> cursor(g.offsets.begin(), g.offsets.end() - 1);
+        for (size_t i = 0; i < from.size(); i++) {
+            g.edges[cursor[from[i]]++] = Edge(to[i], weight[i]);
+            if (!directed) g.edges[cursor[to[i]]++] = Edge(from[i], weight[i]);
+        }
         
-        while (g.m < edges) {
-            int u = rand() % nodes;
-            int v = rand() % nodes;
-            if (u == v) continue; // no self-loops
-            if (!directed && u > v) swap(u, v); // for undirected graphs, normalize edge representation
-            if (usedEdges.find({u, v}) == usedEdges.end()) {
-                int weight = (maxWeight > 1) ? (rand() % maxWeight) + 1 : 1;
-                g.addEdge(u, v, weight);
-                usedEdges.insert({u, v});
+        if (directed) {
+            g.rev_offsets.assign(nodes + 1, 0);
+            for (size_t i = 0; i < to.size(); i++) {
+                g.rev_offsets[to[i] + 1]++;
+            }
+            for (int u = 0; u < nodes; u++) {
+                g.rev_offsets[u + 1] += g.rev_offsets[u];
+            }
+            g.rev_edges.assign(g.rev_offsets[nodes], Edge(0));
+            cursor.assign(g.rev_offsets.begin(), g.rev_offsets.end() - 1);
+            for (size_t i = 0; i < to.size(); i++) {
+                g.rev_edges[cursor[to[i]]++] = Edge(from[i], weight[i]);
             }
         }
         
+        g.frozen = true;
         return g;
     }
     
+    // Generate random graph with n nodes and m edges
+    static Graph generateRandomGraph(int nodes, int edges, bool directed = false, int maxWeight = 1, unsigned seed = 0, int threads = 1) {
+        return generateUniform(nodes, edges, directed, seed, threads, [maxWeight](SplitMix64& rng) {
+            return (maxWeight > 1) ? (int)rng.below(maxWeight) + 1 : 1;
+        });
+    }
+    
     // Generate graph with 0-1 weights
-    static Graph generateRandomGraph01(int nodes, int edges, bool directed = false, double prob0 = 0.3, unsigned seed = 0) {
+    static Graph generateRandomGraph01(int nodes, int edges, bool directed = false, double prob0 = 0.3, unsigned seed = 0, int threads = 1) {
+        return generateUniform(nodes, edges, directed, seed, threads, [prob0](SplitMix64& rng) {
+            return (rng.unit() < prob0) ? 0 : 1;
+        });
+    }
+    
+    static bool isGraphFamily(const string& family) {
+        return family == "RMAT" || family == "GRID2D" || family == "GRID3D" || family == "GEO" ||
+               family == "BA" || family == "CHAIN";
+    }
+    
+    // Structured and skewed graphs, see generateFamily for what edges means per family
+    static Graph generateFamilyGraph(const string& family, int nodes, long edges, bool directed = false, int maxWeight = 1, unsigned seed = 0, int threads = 1) {
+        return generateFamily(family, nodes, edges, directed, seed, threads, [maxWeight](SplitMix64& rng) {
+            return (maxWeight > 1) ? (int)rng.below(maxWeight) + 1 : 1;
+        });
+    }
+    
+    static Graph generateFamilyGraph01(const string& family, int nodes, long edges, bool directed = false, double prob0 = 0.3, unsigned seed = 0, int threads = 1) {
+        return generateFamily(family, nodes, edges, directed, seed, threads, [prob0](SplitMix64& rng) {
+            return (rng.unit() < prob0) ? 0 : 1;
+        });
+    }
+    
+private:
+    // Erdos-Renyi G(n, m) without self-loops or duplicates. Edges are picked as
+    // distinct indices into the list of all possible (u, v) pairs; when more than
+    // half of all pairs are wanted, the missing pairs are sampled instead. The
+    // result only depends on the seed, not on the thread count.
+    template <class WeightFn>
+    static Graph generateUniform(int nodes, int edges, bool directed, unsigned seed, int threads, WeightFn weightOf) {
+        seed = prepareSeed(seed);
+        
+        uint64_t pairs = directed ? (uint64_t)nodes * (nodes - 1) : (uint64_t)nodes * (nodes - 1) / 2;
+        uint64_t target = std::min((uint64_t)max(edges, 0), pairs);
+        bool complement = target > pairs / 2;
+        vector<uint64_t> picked = sampleDistinct(pairs, complement ? pairs - target : target, seed, threads);
+        
+        vector<int> from(target), to(target);
+        PairDecoder decoder(nodes, directed);
+        if (complement) {
+            size_t next = 0, skip = 0;
+            for (uint64_t k = 0; k < pairs; k++) {
+                if (skip < picked.size() && picked[skip] == k) {
+                    skip++;
+                    continue;
+                }
+                decoder.decode(k, from[next], to[next]);
+                next++;
+            }
+        } else {
+            for (size_t i = 0; i < target; i++) {
+                decoder.decode(picked[i], from[i], to[i]);
+            }
+        }
+        
+        return fromEdgeList(nodes, directed, from, to, drawWeights(target, seed, threads, weightOf));
+    }
+    
+    static unsigned prepareSeed(unsigned seed) {
         if (seed == 0) {
             seed = time(NULL);
         }
-        srand(seed);
-        
-        Graph g(nodes, directed);
-        int maxPossibleEdges = directed ? nodes * (nodes - 1) : nodes * (nodes - 1) / 2;
-        edges = min(edges, maxPossibleEdges);
+        srand(seed); // callers still draw their sources from rand()
+        return seed;
+    }
+    
+    template <class WeightFn>
+    static vector<int> drawWeights(uint64_t count, uint64_t seed, int threads, WeightFn weightOf) {
+        vector<int> weight(count);
+        uint64_t blocks = (count + GEN_BLOCK - 1) / GEN_BLOCK;
+        parallelFor(threads, blocks, [&](long, long b0, long b1) {
+            for (long b = b0; b < b1; b++) {
+                SplitMix64 rng = blockStream(seed, GEN_PHASE_WEIGHT, b);
+                uint64_t end = std::min(count, (b + 1) * GEN_BLOCK);
+                for (uint64_t i = b * GEN_BLOCK; i < end; i++) {
+                    weight[i] = weightOf(rng);
+                }
+            }
+        });
+        return weight;
+    }
+    
+    // Generators for the structured families. Each one lists every edge once as
+    // (from, to); undirected graphs store it both ways, directed ones keep the
+    // listed orientation. edges means:
+    //   RMAT   number of edge draws (duplicates and self-loops are dropped)
+    //   GRID2D / GRID3D  ignored; nodes is rounded down to side^2 / side^3
+    //   GEO    target edge count, sets the connection radius of the random
+    //          geometric graph on the unit square (road-network proxy)
+    //   BA     edges / nodes links per new vertex (Barabasi-Albert)
+    //   CHAIN  ignored; a single path 0 - 1 - ... - n-1
+    // Apart from RMAT the generators list edges from the lower id to the higher
+    // one, which would make every directed graph a DAG. Directed graphs of those
+    // families therefore get a random orientation per edge, see orientEdges.
+    template <class WeightFn>
+    static Graph generateFamily(const string& family, int nodes, long edges, bool directed, unsigned seed, int threads, WeightFn weightOf) {
+        seed = prepareSeed(seed);
+        vector<int> from, to;
         
-        set<pair<int, int>> usedEdges;
+        if (family == "RMAT") {
+            rmatEdges(nodes, edges, seed, threads, from, to);
+        } else if (family == "GRID2D" || family == "GRID3D") {
+            int dims = (family == "GRID2D") ? 2 : 3;
+            int side = max(1, (int)floor(pow((double)nodes, 1.0 / dims) + 1e-9));
+            nodes = (dims == 2) ? side * side : side * side * side;
+            gridEdges(side, dims, from, to);
+        } else if (family == "GEO") {
+            geometricEdges(nodes, edges, seed, threads, from, to);
+        } else if (family == "BA") {
+            baEdges(nodes, max(1L, edges / max(nodes, 1)), seed, threads, from, to);
+        } else {
+            for (int u = 0; u + 1 < nodes; u++) {
+                from.push_back(u);
+                to.push_back(u + 1);
+            }
+        }
         
-        while (g.m < edges) {
-            int u = rand() % nodes;
-            int v = rand() % nodes;
-            
-            if (u == v) continue;
-            
+        if (directed && family != "RMAT") orientEdges(seed, threads, from, to);
+        dedupeEdges(directed, from, to);
+        vector<int> weight = drawWeights(from.size(), seed, threads, weightOf);
+        return fromEdgeList(nodes, directed, from, to, weight);
+    }
+    
+    // Flip each edge with probability 1/2 and keep it in both directions with
+    // probability GEN_BOTH_WAYS_PROB, so directed families get cycles and
+    // non-trivial SCCs. Per-block streams keep the result independent of threads.
+    static void orientEdges(uint64_t seed, int threads, vector<int>& from, vector<int>& to) {
+        uint64_t count = from.size();
+        vector<char> bothWays(count, 0);
+        uint64_t blocks = (count + GEN_BLOCK - 1) / GEN_BLOCK;
+        parallelFor(threads, blocks, [&](long, long b0, long b1) {
+            for (long b = b0; b < b1; b++) {
+                SplitMix64 rng = blockStream(seed, GEN_PHASE_ORIENT, b);
+                uint64_t end = std::min(count, (b + 1) * GEN_BLOCK);
+                for (uint64_t i = b * GEN_BLOCK; i < end; i++) {
+                    if (rng.next() & 1) swap(from[i], to[i]);
+                    bothWays[i] = rng.unit() < GEN_BOTH_WAYS_PROB;
+                }
+            }
+        });
+        for (uint64_t i = 0; i < count; i++) {
+            if (bothWays[i]) {
+                from.push_back(to[i]);
+                to.push_back(from[i]);
+            }
+        }
+    }
+    
+    // Drop self-loops and repeated edges (either orientation for undirected graphs)
+    static void dedupeEdges(bool directed, vector<int>& from, vector<int>& to) {
+        vector<uint64_t> keys;
+        keys.reserve(from.size());
+        for (size_t i = 0; i < from.size(); i++) {
+            if (from[i] == to[i]) continue;
+            uint64_t u = from[i], v = to[i];
             if (!directed && u > v) swap(u, v);
-            
-            if (usedEdges.find({u, v}) == usedEdges.end()) {
-                double r = (double)rand() / RAND_MAX;
-                int weight = (r < prob0) ? 0 : 1;
-                g.addEdge(u, v, weight);
-                usedEdges.insert({u, v});
+            keys.push_back(u << 32 | v);
+        }
+        sort(keys.begin(), keys.end());
+        keys.erase(unique(keys.begin(), keys.end()), keys.end());
+        from.resize(keys.size());
+        to.resize(keys.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+            from[i] = keys[i] >> 32;
+            to[i] = (uint32_t)keys[i];
+        }
+    }
+    
+    // R-MAT: every draw descends the adjacency matrix one bit level at a time,
+    // picking a quadrant with probabilities a, b, c, d. Draws that land outside
+    // [0, nodes) are redrawn, and vertex ids are shuffled afterwards so that the
+    // high-degree vertices are not all at small ids.
+    static void rmatEdges(int nodes, long draws, uint64_t seed, int threads, vector<int>& from, vector<int>& to) {
+        int scale = 0;
+        while ((1LL << scale) < nodes) scale++;
+        from.assign(draws, 0);
+        to.assign(draws, 0);
+        uint64_t blocks = (draws + GEN_BLOCK - 1) / GEN_BLOCK;
+        parallelFor(threads, blocks, [&](long, long b0, long b1) {
+            for (long b = b0; b < b1; b++) {
+                SplitMix64 rng = blockStream(seed, GEN_PHASE_FAMILY, b);
+                long end = std::min((uint64_t)draws, (b + 1) * GEN_BLOCK);
+                for (long i = b * GEN_BLOCK; i < end; i++) {
+                    uint64_t u, v;
+                    do {
+                        u = 0;
+                        v = 0;
+                        for (int level = 0; level < scale; level++) {
+                            double r = rng.unit();
+                            bool lowerHalf = r >= RMAT_A + RMAT_B;
+                            bool rightHalf = (r >= RMAT_A && !lowerHalf) || r >= RMAT_A + RMAT_B + RMAT_C;
+                            u = u << 1 | lowerHalf;
+                            v = v << 1 | rightHalf;
+                        }
+                    } while (u >= (uint64_t)nodes || v >= (uint64_t)nodes);
+                    from[i] = u;
+                    to[i] = v;
+                }
+            }
+        });
+        
+        vector<int> label(nodes);
+        for (int v = 0; v < nodes; v++) label[v] = v;
+        SplitMix64 rng = blockStream(seed, GEN_PHASE_PERMUTE, 0);
+        for (int v = nodes - 1; v > 0; v--) {
+            swap(label[v], label[rng.below(v + 1)]);
+        }
+        parallelFor(threads, draws, [&](long, long begin, long end) {
+            for (long i = begin; i < end; i++) {
+                from[i] = label[from[i]];
+                to[i] = label[to[i]];
+            }
+        });
+    }
+    
+    // Lattice edges to the next vertex along every axis; vertex (x, y, z) is x + side * (y + side * z)
+    static void gridEdges(int side, int dims, vector<int>& from, vector<int>& to) {
+        int depth = (dims == 3) ? side : 1;
+        for (int z = 0; z < depth; z++) {
+            for (int y = 0; y < side; y++) {
+                for (int x = 0; x < side; x++) {
+                    int v = x + side * (y + side * z);
+                    if (x + 1 < side) { from.push_back(v); to.push_back(v + 1); }
+                    if (y + 1 < side) { from.push_back(v); to.push_back(v + side); }
+                    if (z + 1 < depth) { from.push_back(v); to.push_back(v + side * side); }
+                }
             }
         }
+    }
+    
+    // Random geometric graph: uniform points in the unit square, joined when closer
+    // than r, with r chosen so the expected edge count is edges. Points are bucketed
+    // into r-sized cells and each vertex block only scans the 3x3 neighbouring cells;
+    // blocks are concatenated in vertex order, so the result ignores the thread count.
+    static void geometricEdges(int nodes, long edges, uint64_t seed, int threads, vector<int>& from, vector<int>& to) {
+        vector<double> px(nodes), py(nodes);
+        uint64_t pointBlocks = ((uint64_t)nodes + GEN_BLOCK - 1) / GEN_BLOCK;
+        parallelFor(threads, pointBlocks, [&](long, long b0, long b1) {
+            for (long b = b0; b < b1; b++) {
+                SplitMix64 rng = blockStream(seed, GEN_PHASE_FAMILY, b);
+                long end = std::min((uint64_t)nodes, (b + 1) * GEN_BLOCK);
+                for (long i = b * GEN_BLOCK; i < end; i++) {
+                    px[i] = rng.unit();
+                    py[i] = rng.unit();
+                }
+            }
+        });
         
-        return g;
+        double radius = sqrt(2.0 * edges / ((double)nodes * nodes * M_PI));
+        int cells = max(1, min((int)(1.0 / max(radius, 1e-9)), (int)sqrt((double)nodes) + 1));
+        auto cellOf = [&](int v) {
+            int cx = min(cells - 1, (int)(px[v] * cells));
+            int cy = min(cells - 1, (int)(py[v] * cells));
+            return cy * cells + cx;
+        };
+        vector<int> cellStart((size_t)cells * cells + 1, 0);
+        for (int v = 0; v < nodes; v++) cellStart[cellOf(v) + 1]++;
+        for (size_t c = 0; c + 1 < cellStart.size(); c++) cellStart[c + 1] += cellStart[c];
+        vector<int> cellPoints(nodes);
+        vector<int> cursor(cellStart.begin(), cellStart.end() - 1);
+        for (int v = 0; v < nodes; v++) cellPoints[cursor[cellOf(v)]++] = v;
+        
+        double r2 = radius * radius;
+        uint64_t blocks = pointBlocks;
+        vector<vector<int>> blockFrom(blocks), blockTo(blocks);
+        parallelFor(threads, blocks, [&](long, long b0, long b1) {
+            for (long b = b0; b < b1; b++) {
+                long end = std::min((uint64_t)nodes, (b + 1) * GEN_BLOCK);
+                for (long u = b * GEN_BLOCK; u < end; u++) {
+                    int cx = min(cells - 1, (int)(px[u] * cells));
+                    int cy = min(cells - 1, (int)(py[u] * cells));
+                    for (int y = max(0, cy - 1); y <= min(cells - 1, cy + 1); y++) {
+                        for (int x = max(0, cx - 1); x <= min(cells - 1, cx + 1); x++) {
+                            int c = y * cells + x;
+                            for (int i = cellStart[c]; i < cellStart[c + 1]; i++) {
+                                int v = cellPoints[i];
+                                double dx = px[u] - px[v], dy = py[u] - py[v];
+                                if (v > u && dx * dx + dy * dy < r2) {
+                                    blockFrom[b].push_back(u);
+                                    blockTo[b].push_back(v);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        });
+        for (uint64_t b = 0; b < blocks; b++) {
+            from.insert(from.end(), blockFrom[b].begin(), blockFrom[b].end());
+            to.insert(to.end(), blockTo[b].begin(), blockTo[b].end());
+        }
+    }
+    
+    // Barabasi-Albert by the copy model, which lets every edge be drawn on its own:
+    // vertex s >= 1 adds edges e = (s-1)*k .. s*k-1, and edge e links to the vertex
+    // at a uniformly chosen endpoint slot of the earlier edges. An even slot is an
+    // earlier edge's source (known directly), an odd slot its target, which is
+    // resolved the same way for a strictly smaller edge index.
+    static int baTarget(uint64_t e, long k, uint64_t seed) {
+        while (true) {
+            uint64_t src = e / k + 1;
+            if (src == 1) return 0;
+            SplitMix64 rng(seed ^ (e * 0x9E3779B97F4A7C15ULL));
+            rng.next();
+            uint64_t slot = rng.below(2 * (src - 1) * k);
+            if (slot % 2 == 0) return (slot / 2) / k + 1;
+            e = slot / 2;
+        }
+    }
+    
+    static void baEdges(int nodes, long k, uint64_t seed, int threads, vector<int>& from, vector<int>& to) {
+        long count = (nodes > 1) ? (long)(nodes - 1) * k : 0;
+        from.assign(count, 0);
+        to.assign(count, 0);
+        uint64_t mixed = blockStream(seed, GEN_PHASE_FAMILY, 0).next();
+        parallelFor(threads, count, [&](long, long begin, long end) {
+            for (long e = begin; e < end; e++) {
+                from[e] = e / k + 1;
+                to[e] = baTarget(e, k, mixed);
+            }
+        });
+    }
+    
+    // Sorted, uniformly random subset of want distinct values from [0, total).
+    // Candidates are drawn in fixed-size blocks with per-block streams, then
+    // deduplicated by sorting; rounds repeat until enough distinct values exist.
+    static vector<uint64_t> sampleDistinct(uint64_t total, uint64_t want, uint64_t seed, int threads) {
+        vector<uint64_t> pool;
+        for (uint64_t round = 0; pool.size() < want; round++) {
+            uint64_t need = want - pool.size();
+            uint64_t draws = need + need / 16 + 64;
+            size_t old = pool.size();
+            pool.resize(old + draws);
+            uint64_t blocks = (draws + GEN_BLOCK - 1) / GEN_BLOCK;
+            parallelFor(threads, blocks, [&](long, long b0, long b1) {
+                for (long b = b0; b < b1; b++) {
+                    SplitMix64 rng = blockStream(seed, round, b);
+                    uint64_t end = std::min(draws, (b + 1) * GEN_BLOCK);
+                    for (uint64_t i = b * GEN_BLOCK; i < end; i++) {
+                        pool[old + i] = rng.below(total);
+                    }
+                }
+            });
+            sort(pool.begin(), pool.end());
+            pool.erase(unique(pool.begin(), pool.end()), pool.end());
+        }
+        
+        if (pool.size() > want) {
+            SplitMix64 rng = blockStream(seed, GEN_PHASE_TRIM, 0);
+            for (uint64_t i = 0; i < want; i++) {
+                swap(pool[i], pool[i + rng.below(pool.size() - i)]);
+            }
+            pool.resize(want);
+            sort(pool.begin(), pool.end());
+        }
+        return pool;
+    }
+    
+    static uint64_t alignFilePos(uint64_t pos) {
+        return (pos + 63) / 64 * 64;
+    }
+    
+    // True when count items of itemSize bytes starting at pos lie inside the
+    // file and pos is aligned for them; written so that nothing can overflow
+    static bool sectionFits(uint64_t pos, uint64_t count, uint64_t itemSize, uint64_t length) {
+        if (pos > length || pos % sizeof(int) != 0) return false;
+        return count <= (length - pos) / itemSize;
+    }
+    
+    // A CSR section is usable when its offsets start at 0, never decrease and
+    // end at edgeCount, and every edge target is a vertex below n
+    static bool validCSR(const int* off, const Edge* list, uint64_t n, uint64_t edgeCount) {
+        if (off[0] != 0) return false;
+        for (uint64_t u = 0; u < n; u++) {
+            if (off[u] > off[u + 1]) return false;
+        }
+        if ((uint64_t)off[n] != edgeCount) return false;
+        for (uint64_t i = 0; i < edgeCount; i++) {
+            if (list[i].to < 0 || (uint64_t)list[i].to >= n) return false;
+        }
+        return true;
+    }
+    
+    static bool writeAt(FILE* f, uint64_t pos, const void* data, size_t bytes) {
+        if (fseeko(f, pos, SEEK_SET) != 0) return false;
+        return fwrite(data, 1, bytes, f) == bytes;
+    }
+    
+    static void packCSR(vector<vector<Edge>>& lists, vector<int>& off, vector<Edge>& packed) {
+        off.assign(lists.size() + 1, 0);
+        for (size_t u = 0; u < lists.size(); u++) {
+            off[u + 1] = off[u] + (int)lists[u].size();
+        }
+        packed.clear();
+        packed.reserve(off.back());
+        for (size_t u = 0; u < lists.size(); u++) {
+            packed.insert(packed.end(), lists[u].begin(), lists[u].end());
+            vector<Edge>().swap(lists[u]);
+        }
+        vector<vector<Edge>>().swap(lists);
     }
 };
 
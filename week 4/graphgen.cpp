@@ -0,0 +1,81 @@
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+#include "graph.h"
+
+using namespace std;
+
+// Generates a graph once and writes it in the binary CSR format, so prob1,
+// prob2 and prob3 can mmap it with type FILE instead of regenerating it.
+int main(int argc, char* argv[]) {
+    if (argc < 8 || argc > 9) {
+        cout << "Use: <graphType> <nodes> <edgesOrSparsity> <seed> <directed|undirected> <weightType> <outFile> [threads]" << endl;
+        cout << "Types: VARM, VARN, RMAT, GRID2D, GRID3D, GEO, BA, CHAIN" << endl;
+        cout << "VARN: sparsity=1(2n),2(nlogn),3(nsqrt(n)),4(max)" << endl;
+        cout << "Weights: unweighted, 01, wbfs_c" << endl;
+        return 0;
+    }
+
+    string graphType = argv[1];
+    unsigned long nodeCount = atoi(argv[2]);
+    unsigned long edgeParam = atoi(argv[3]);
+    unsigned int seedValue = atoi(argv[4]);
+    string direction = argv[5];
+    string weightKind = argv[6];
+    string outFile = argv[7];
+    long threadCount = (argc == 9) ? atol(argv[8]) : thread::hardware_concurrency();
+    if (threadCount <= 0) threadCount = 1;
+
+    if (direction != "directed" && direction != "undirected") {
+        cout << "Error: bad direction" << endl;
+        return 1;
+    }
+    bool directed = (direction == "directed");
+
+    unsigned long edgeCount;
+    if (graphType == "VARM" || Graph::isGraphFamily(graphType)) {
+        edgeCount = edgeParam;
+    } else if (graphType == "VARN") {
+        if (edgeParam == 1) {
+            edgeCount = nodeCount * 2;
+        } else if (edgeParam == 2) {
+            edgeCount = nodeCount * (unsigned long)(log(nodeCount) + 0.5);
+        } else if (edgeParam == 3) {
+            edgeCount = nodeCount * (unsigned long)sqrt(nodeCount);
+        } else if (edgeParam == 4) {
+            edgeCount = nodeCount * (nodeCount - 1) / (directed ? 1 : 2);
+        } else {
+            cout << "Error: bad sparsity" << endl;
+            return 1;
+        }
+    } else {
+        cout << "Error: bad graph type" << endl;
+        return 1;
+    }
+
+    bool family = Graph::isGraphFamily(graphType);
+    Graph g(1);
+    if (weightKind == "unweighted") {
+        g = family ? Graph::generateFamilyGraph(graphType, nodeCount, edgeCount, directed, 1, seedValue, threadCount)
+                   : Graph::generateRandomGraph(nodeCount, edgeCount, directed, 1, seedValue, threadCount);
+    } else if (weightKind == "01") {
+        g = family ? Graph::generateFamilyGraph01(graphType, nodeCount, edgeCount, directed, 0.3, seedValue, threadCount)
+                   : Graph::generateRandomGraph01(nodeCount, edgeCount, directed, 0.3, seedValue, threadCount);
+    } else if (weightKind.substr(0, 5) == "wbfs_") {
+        long maxW = atoi(weightKind.substr(5).c_str());
+        g = family ? Graph::generateFamilyGraph(graphType, nodeCount, edgeCount, directed, maxW, seedValue, threadCount)
+                   : Graph::generateRandomGraph(nodeCount, edgeCount, directed, maxW, seedValue, threadCount);
+    } else {
+        cout << "Error: bad weight type" << endl;
+        return 1;
+    }
+
+    if (!g.saveBinary(outFile)) {
+        cout << "Error: cannot write " << outFile << endl;
+        return 1;
+    }
+    cout << "GRAPH_FILE," << graphType << "," << g.n << "," << g.m << "," << outFile << endl;
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "graph.h"
+#include "visited.h"
 #include <queue>
 #include <stack>
 #include <cmath>
@@ -6,27 +7,101 @@
 #include <chrono>
 #include <cstring>
 #include <vector>
+#include <cstdint>
+#include <atomic>
+#include <pthread.h>
+#include <thread>
 using namespace std;
 
-void bfsTraversal(const Graph& graph, unsigned int startVertex, vector<bool>& isVisited) {
+void bfsTraversal(const Graph& graph, unsigned int startVertex, VisitedSet& isVisited) {
     queue<unsigned int> q;
     q.push(startVertex);
-    isVisited[startVertex] = true;
+    isVisited.set(startVertex);
     
     while (!q.empty()) {
         unsigned int u = q.front();
         q.pop();
         
-        for (const Edge& edge : graph.adj[u]) {
-            if (!isVisited[edge.to]) {
-                isVisited[edge.to] = true;
+        for (const Edge& edge : graph.out(u)) {
+            if (!isVisited.testAndSet(edge.to)) {
                 q.push(edge.to);
             }
         }
     }
 }
 
-void dfsTraversalIter(const Graph& graph, unsigned int startVertex, vector<bool>& isVisited) {
+// Direction-optimizing BFS switch thresholds (Beamer et al.)
+const long long HYBRID_ALPHA = 14;
+const long long HYBRID_BETA = 24;
+
+// Top-down while the frontier is small, bottom-up (every unvisited vertex looks
+// for a parent in the frontier bitmap) while it covers a large share of the edges.
+// unexploredEdges is the degree sum of the still unvisited vertices.
+void bfsHybrid(const Graph& graph, unsigned int startVertex, VisitedSet& isVisited, long long& unexploredEdges) {
+    size_t words = ((size_t)graph.n + 63) / 64;
+    vector<unsigned int> frontier, nextFrontier;
+    vector<uint64_t> frontierBits, nextBits;
+    bool bottomUp = false;
+    
+    isVisited.set(startVertex);
+    frontier.push_back(startVertex);
+    long long frontierEdges = graph.out(startVertex).size();
+    long long frontierSize = 1;
+    unexploredEdges -= frontierEdges;
+    
+    while (frontierSize > 0) {
+        if (!bottomUp && frontierEdges > unexploredEdges / HYBRID_ALPHA) {
+            frontierBits.assign(words, 0);
+            nextBits.assign(words, 0);
+            for (unsigned int v : frontier) {
+                frontierBits[v >> 6] |= 1ULL << (v & 63);
+            }
+            bottomUp = true;
+        } else if (bottomUp && frontierSize < graph.n / HYBRID_BETA) {
+            frontier.clear();
+            for (size_t w = 0; w < words; w++) {
+                for (uint64_t bits = frontierBits[w]; bits; bits &= bits - 1) {
+                    frontier.push_back(w * 64 + __builtin_ctzll(bits));
+                }
+            }
+            bottomUp = false;
+        }
+        
+        frontierEdges = 0;
+        frontierSize = 0;
+        if (bottomUp) {
+            fill(nextBits.begin(), nextBits.end(), 0);
+            for (unsigned int v = 0; v < (unsigned int)graph.n; v++) {
+                if (isVisited[v]) continue;
+                for (const Edge& edge : graph.directed ? graph.in(v) : graph.out(v)) {
+                    if (frontierBits[edge.to >> 6] >> (edge.to & 63) & 1) {
+                        isVisited.set(v);
+                        nextBits[v >> 6] |= 1ULL << (v & 63);
+                        frontierSize++;
+                        frontierEdges += graph.out(v).size();
+                        break;
+                    }
+                }
+            }
+            frontierBits.swap(nextBits);
+        } else {
+            nextFrontier.clear();
+            for (unsigned int u : frontier) {
+                for (const Edge& edge : graph.out(u)) {
+                    if (!isVisited.testAndSet(edge.to)) {
+                        nextFrontier.push_back(edge.to);
+                        frontierEdges += graph.out(edge.to).size();
+                    }
+                }
+            }
+            frontier.swap(nextFrontier);
+            frontierSize = frontier.size();
+        }
+        unexploredEdges -= frontierEdges;
+    }
+}
+
+void dfsTraversalIter(const Graph& graph, unsigned int startVertex, VisitedSet& isVisited) {
     stack<unsigned int> nodeStack;
     nodeStack.push(startVertex);
     
@@ -34,9 +109,8 @@ void dfsTraversalIter(const Graph& graph, unsigned int startVertex, vector<bool>
         unsigned int currentNode = nodeStack.top();
         nodeStack.pop();
         
-        if (!isVisited[currentNode]) {
-            isVisited[currentNode] = true;
-            for (const Edge& edge : graph.adj[currentNode]) {
+        if (!isVisited.testAndSet(currentNode)) {
+            for (const Edge& edge : graph.out(currentNode)) {
                 if (!isVisited[edge.to]) {
                     nodeStack.push(edge.to);
                 }
@@ -45,22 +119,22 @@ void dfsTraversalIter(const Graph& graph, unsigned int startVertex, vector<bool>
     }
 }
 
-void dfsRecurse(const Graph& graph, unsigned int node, vector<bool>& isVisited) {
-    isVisited[node] = true;
+void dfsRecurse(const Graph& graph, unsigned int node, VisitedSet& isVisited) {
+    isVisited.set(node);
     
-    for (const Edge& edge : graph.adj[node]) {
+    for (const Edge& edge : graph.out(node)) {
         if (!isVisited[edge.to]) {
             dfsRecurse(graph, edge.to, isVisited);
         }
     }
 }
 
-void dfsTraversalRec(const Graph& graph, unsigned int startVertex, vector<bool>& isVisited) {
+void dfsTraversalRec(const Graph& graph, unsigned int startVertex, VisitedSet& isVisited) {
     dfsRecurse(graph, startVertex, isVisited);
 }
 
 void runFullBfs(const Graph& graph) {
-    vector<bool> isVisited(graph.n, false);
+    VisitedSet isVisited(graph.n);
     unsigned int vertex = 0;
     while (vertex < graph.n) {
         if (!isVisited[vertex]) {
@@ -70,8 +144,149 @@ void runFullBfs(const Graph& graph) {
     }
 }
 
+void runFullHybridBfs(const Graph& graph) {
+    VisitedSet isVisited(graph.n);
+    long long unexploredEdges = 0;
+    for (unsigned int vertex = 0; vertex < graph.n; vertex++) {
+        unexploredEdges += graph.out(vertex).size();
+    }
+    for (unsigned int vertex = 0; vertex < graph.n; vertex++) {
+        if (!isVisited[vertex]) {
+            bfsHybrid(graph, vertex, isVisited, unexploredEdges);
+        }
+    }
+}
+
+// Shared state of one level-synchronous parallel BFS over the whole graph.
+// Threads expand chunks of frontiers[depth & 1] into private buffers, which are
+// then copied at prefix offsets into the other frontier buffer.
+struct ParallelBfsState {
+    const Graph* graph;
+    long threadCount;
+    AtomicVisitedSet visited;
+    vector<int> levels;
+    vector<unsigned int> frontiers[2];
+    vector<vector<unsigned int>> localNext;
+    vector<size_t> localOffsets;
+    atomic<size_t> nextChunk;
+    int depth;
+    unsigned int nextRoot;
+    bool done;
+    pthread_barrier_t barrier;
+};
+
+struct BfsThreadData {
+    long threadNum;
+    ParallelBfsState* state;
+};
+
+const size_t BFS_CHUNK = 64;
+
+// Serial step between levels, run by thread 0: size the next frontier, or start
+// a new component from the next unvisited root once the current one is exhausted
+void advanceLevel(ParallelBfsState* st) {
+    vector<unsigned int>& next = st->frontiers[(st->depth + 1) & 1];
+    size_t total = 0;
+    for (long t = 0; t < st->threadCount; t++) {
+        st->localOffsets[t] = total;
+        total += st->localNext[t].size();
+    }
+    next.resize(total);
+    st->depth++;
+    st->nextChunk.store(0, memory_order_relaxed);
+    if (total > 0) return;
+    
+    while (st->nextRoot < (unsigned int)st->graph->n && st->visited.testAndSet(st->nextRoot)) {
+        st->nextRoot++;
+    }
+    if (st->nextRoot == (unsigned int)st->graph->n) {
+        st->done = true;
+        return;
+    }
+    st->levels[st->nextRoot] = 0;
+    st->depth = 0;
+    st->frontiers[0].assign(1, st->nextRoot);
+    for (long t = 0; t < st->threadCount; t++) {
+        st->localNext[t].clear();
+    }
+}
+
+void* parallelBfsWorker(void* arg) {
+    BfsThreadData* data = (BfsThreadData*)arg;
+    ParallelBfsState* st = data->state;
+    const Graph& graph = *st->graph;
+    vector<unsigned int>& local = st->localNext[data->threadNum];
+    
+    while (true) {
+        const vector<unsigned int>& frontier = st->frontiers[st->depth & 1];
+        int nextLevel = st->depth + 1;
+        local.clear();
+        while (true) {
+            size_t begin = st->nextChunk.fetch_add(BFS_CHUNK, memory_order_relaxed);
+            if (begin >= frontier.size()) break;
+            size_t end = min(begin + BFS_CHUNK, frontier.size());
+            for (size_t i = begin; i < end; i++) {
+                for (const Edge& edge : graph.out(frontier[i])) {
+                    if (!st->visited.testAndSet(edge.to)) {
+                        st->levels[edge.to] = nextLevel;
+                        local.push_back(edge.to);
+                    }
+                }
+            }
+        }
+        
+        pthread_barrier_wait(&st->barrier);
+        if (data->threadNum == 0) {
+            advanceLevel(st);
+        }
+        pthread_barrier_wait(&st->barrier);
+        if (st->done) break;
+        
+        if (!local.empty()) {
+            vector<unsigned int>& next = st->frontiers[st->depth & 1];
+            copy(local.begin(), local.end(), next.begin() + st->localOffsets[data->threadNum]);
+        }
+        pthread_barrier_wait(&st->barrier);
+    }
+    
+    return nullptr;
+}
+
+// Level of every vertex from the root of its component, with roots taken in
+// vertex order exactly like runFullBfs
+vector<int> runFullParallelBfs(const Graph& graph, long threadCount) {
+    ParallelBfsState st;
+    st.graph = &graph;
+    st.threadCount = threadCount;
+    st.visited.resize(graph.n);
+    st.levels.assign(graph.n, -1);
+    st.localNext.resize(threadCount);
+    st.localOffsets.resize(threadCount);
+    st.nextChunk.store(0);
+    st.depth = 0;
+    st.nextRoot = 0;
+    st.done = false;
+    advanceLevel(&st);
+    if (st.done) return st.levels;
+    
+    pthread_barrier_init(&st.barrier, nullptr, threadCount);
+    vector<pthread_t> threads(threadCount);
+    vector<BfsThreadData> threadData(threadCount);
+    for (long i = 0; i < threadCount; i++) {
+        threadData[i].threadNum = i;
+        threadData[i].state = &st;
+        pthread_create(&threads[i], nullptr, parallelBfsWorker, &threadData[i]);
+    }
+    for (long i = 0; i < threadCount; i++) {
+        pthread_join(threads[i], nullptr);
+    }
+    pthread_barrier_destroy(&st.barrier);
+    
+    return st.levels;
+}
+
 void runFullDfsIter(const Graph& graph) {
-    vector<bool> isVisited(graph.n, false);
+    VisitedSet isVisited(graph.n);
     for (unsigned int vertex = 0; vertex < graph.n; vertex++) {
         if (!isVisited[vertex]) {
             dfsTraversalIter(graph, vertex, isVisited);
@@ -80,7 +295,7 @@ void runFullDfsIter(const Graph& graph) {
 }
 
 void runFullDfsRec(const Graph& graph) {
-    vector<bool> isVisited(graph.n, false);
+    VisitedSet isVisited(graph.n);
     unsigned int vertex = 0;
     do {
         if (!isVisited[vertex]) {
@@ -92,23 +307,29 @@ void runFullDfsRec(const Graph& graph) {
 
 int main(int argc, char* argv[]) {
     
-    if (argc < 5 || argc > 6) {
-        cout << "Use: <graphType> <nodes> <sparsityOrEdges> <seed> [algo]" << endl;
-        cout << "Types: VARM, VARN" << endl;
+    if (argc < 5 || argc > 7) {
+        cout << "Use: <graphType> <nodes> <sparsityOrEdges> <seed> [algo] [threads]" << endl;
+        cout << "Types: VARM, VARN, RMAT, GRID2D, GRID3D, GEO, BA, CHAIN, FILE" << endl;
+        cout << "FILE: nodes is the path of a graph written by graphgen, edges ignored" << endl;
+        cout << "RMAT/GEO: nodes, edges; BA: nodes, edges (edges/nodes links per vertex); GRID2D/GRID3D/CHAIN: nodes, ignored" << endl;
         cout << "VARM: nodes, edges" << endl;
         cout << "VARN: sparsity=1(2n),2(nlogn),3(nsqrt(n)),4(max)" << endl;
-        cout << "Algo: bfs,dfs_iter,dfs_rec" << endl;
+        cout << "Algo: bfs,dfs_iter,dfs_rec,bfs_hybrid,bfs_parallel" << endl;
         return 0;
     }
     
     unsigned int nodeCount = atoi(argv[2]);
     unsigned int edgeParam = atoi(argv[3]);
     unsigned int seedVal = atoi(argv[4]);
-    string algoChoice = (argc == 6) ? argv[5] : "all";
+    string algoChoice = (argc >= 6) ? argv[5] : "all";
+    long threadCount = (argc == 7) ? atol(argv[6]) : thread::hardware_concurrency();
+    if (threadCount <= 0) threadCount = 1;
     string graphKind = argv[1];
     
-    unsigned int edgeCount;
-    if (graphKind == "VARM") {
+    unsigned int edgeCount = 0;
+    if (graphKind == "FILE") {
+        srand(seedVal);
+    } else if (graphKind == "VARM") {
         edgeCount = edgeParam;
     } else if (graphKind == "VARN") {
         if (edgeParam == 1) {
@@ -123,12 +344,29 @@ int main(int argc, char* argv[]) {
             cout << "Invalid sparsity" << endl;
             return 0;
         }
+    } else if (Graph::isGraphFamily(graphKind)) {
+        edgeCount = edgeParam;
     } else {
         cout << "Wrong graph type" << endl;
         return 0;
     }
     
-    Graph g = Graph::generateRandomGraph(nodeCount, edgeCount, false, 1, seedVal);
+    Graph g(1);
+    if (graphKind == "FILE") {
+        if (!Graph::loadBinary(argv[2], g)) {
+            cout << "Cannot load graph file " << argv[2] << endl;
+            return 0;
+        }
+        nodeCount = g.n;
+        edgeCount = g.m;
+    } else if (Graph::isGraphFamily(graphKind)) {
+        g = Graph::generateFamilyGraph(graphKind, nodeCount, edgeCount, false, 1, seedVal, threadCount);
+        nodeCount = g.n;
+        edgeCount = g.m;
+    } else {
+        g = Graph::generateRandomGraph(nodeCount, edgeCount, false, 1, seedVal, threadCount);
+    }
+    g.freeze();
     
     if (algoChoice == "all") {
         auto startTime = chrono::high_resolution_clock::now();
@@ -146,9 +384,21 @@ int main(int argc, char* argv[]) {
         endTime = chrono::high_resolution_clock::now();
         long long dfsRecTime = chrono::duration_cast<chrono::microseconds>(endTime - startTime).count();
         
+        startTime = chrono::high_resolution_clock::now();
+        runFullHybridBfs(g);
+        endTime = chrono::high_resolution_clock::now();
+        long long bfsHybridTime = chrono::duration_cast<chrono::microseconds>(endTime - startTime).count();
+        
+        startTime = chrono::high_resolution_clock::now();
+        runFullParallelBfs(g, threadCount);
+        endTime = chrono::high_resolution_clock::now();
+        long long bfsParallelTime = chrono::duration_cast<chrono::microseconds>(endTime - startTime).count();
+        
         cout << "GRAPH_TRAVERSAL," << graphKind << "," << nodeCount << "," << edgeCount << ",BFS," << bfsTime << endl;
         cout << "GRAPH_TRAVERSAL," << graphKind << "," << nodeCount << "," << edgeCount << ",DFS_ITER," << dfsIterTime << endl;
         cout << "GRAPH_TRAVERSAL," << graphKind << "," << nodeCount << "," << edgeCount << ",DFS_REC," << dfsRecTime << endl;
+        cout << "GRAPH_TRAVERSAL," << graphKind << "," << nodeCount << "," << edgeCount << ",BFS_HYBRID," << bfsHybridTime << endl;
+        cout << "GRAPH_TRAVERSAL," << graphKind << "," << nodeCount << "," << edgeCount << ",BFS_PARALLEL," << bfsParallelTime << "," << threadCount << endl;
     } else {
         auto startTime = chrono::high_resolution_clock::now();
         string algoName;
@@ -162,6 +412,12 @@ int main(int argc, char* argv[]) {
         } else if (algoChoice == "dfs_rec") {
             runFullDfsRec(g);
             algoName = "DFS_REC";
+        } else if (algoChoice == "bfs_hybrid") {
+            runFullHybridBfs(g);
+            algoName = "BFS_HYBRID";
+        } else if (algoChoice == "bfs_parallel") {
+            runFullParallelBfs(g, threadCount);
+            algoName = "BFS_PARALLEL";
         } else {
             cout << "Bad algo: " << algoChoice << endl;
             return 1;
@@ -170,7 +426,11 @@ int main(int argc, char* argv[]) {
         auto endTime = chrono::high_resolution_clock::now();
         long long execTime = chrono::duration_cast<chrono::microseconds>(endTime - startTime).count();
         
-        cout << "GRAPH_TRAVERSAL," << graphKind << "," << nodeCount << "," << edgeCount << "," << algoName << "," << execTime << endl;
+        cout << "GRAPH_TRAVERSAL," << graphKind << "," << nodeCount << "," << edgeCount << "," << algoName << "," << execTime;
+        if (algoChoice == "bfs_parallel") {
+            cout << "," << threadCount;
+        }
+        cout << endl;
     }
     
     return 0;
@@ -7,29 +7,95 @@
 #include <functional>
 #include <cmath>
 #include <limits>
+#include <atomic>
+#include <pthread.h>
+#include <thread>
+#include <cstdint>
+#include <memory>
 using namespace std;
 
 const int INF = numeric_limits<int>::max();
 
-vector<long> dijkstraPath(const Graph& g, unsigned long src) {
+// Binary heap of (distance, vertex) with lazy deletion of stale entries
+struct BinaryHeapQueue {
+    priority_queue<pair<long, unsigned long>, vector<pair<long, unsigned long>>, greater<pair<long, unsigned long>>> heap;
+    
+    bool empty() const { return heap.empty(); }
+    
+    // Lower bound on the smallest live key (the top may be stale)
+    long topKey() const { return heap.top().first; }
+    
+    void push(long dist, unsigned long node) { heap.push({dist, node}); }
+    
+    pair<long, unsigned long> pop() {
+        pair<long, unsigned long> top = heap.top();
+        heap.pop();
+        return top;
+    }
+};
+
+// Monotone radix heap: Dijkstra never pushes a key below the last popped one, so
+// an entry lives in bucket bitWidth(key ^ last) and only moves to lower buckets
+// when last advances. Push is O(1), pop is amortized O(log C) for max weight C.
+struct RadixHeapQueue {
+    vector<pair<long, unsigned long>> buckets[65];
+    long last;
+    size_t count;
+    
+    RadixHeapQueue() : last(0), count(0) {}
+    
+    static int bucketOf(long key, long base) {
+        return key == base ? 0 : 64 - __builtin_clzl((unsigned long)(key ^ base));
+    }
+    
+    bool empty() const { return count == 0; }
+    
+    void push(long dist, unsigned long node) {
+        buckets[bucketOf(dist, last)].push_back({dist, node});
+        count++;
+    }
+    
+    pair<long, unsigned long> pop() {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) i++;
+            long minKey = buckets[i][0].first;
+            for (const pair<long, unsigned long>& item : buckets[i]) {
+                minKey = min(minKey, item.first);
+            }
+            last = minKey;
+            for (const pair<long, unsigned long>& item : buckets[i]) {
+                buckets[bucketOf(item.first, last)].push_back(item);
+            }
+            buckets[i].clear();
+        }
+        pair<long, unsigned long> top = buckets[0].back();
+        buckets[0].pop_back();
+        count--;
+        return top;
+    }
+};
+
+template <class Queue>
+vector<long> dijkstraWith(const Graph& g, unsigned long src) {
     vector<long> distances(g.n, INF);
-    priority_queue<pair<long, unsigned long>, vector<pair<long, unsigned long>>, greater<pair<long, unsigned long>>> pqNodes;
+    Queue pqNodes;
     
     distances[src] = 0;
-    pqNodes.push({0, src});
+    pqNodes.push(0, src);
     
     while (!pqNodes.empty()) {
-        long currDist = pqNodes.top().first;
-        unsigned long node = pqNodes.top().second;
-        pqNodes.pop();
+        pair<long, unsigned long> top = pqNodes.pop();
+        long currDist = top.first;
+        unsigned long node = top.second;
         
         if (currDist > distances[node]) continue;
         
-        for (const Edge& edge : g.adj[node]) {
+        for (const Edge& edge : g.out(node)) {
             long newDist = distances[node] + edge.weight;
             if (newDist < distances[edge.to]) {
                 distances[edge.to] = newDist;
-                pqNodes.push({newDist, edge.to});
+                pqNodes.push(newDist, edge.to);
             }
         }
     }
@@ -37,6 +103,14 @@ vector<long> dijkstraPath(const Graph& g, unsigned long src) {
     return distances;
 }
 
+vector<long> dijkstraPath(const Graph& g, unsigned long src) {
+    return dijkstraWith<BinaryHeapQueue>(g, src);
+}
+
+vector<long> dijkstraRadix(const Graph& g, unsigned long src) {
+    return dijkstraWith<RadixHeapQueue>(g, src);
+}
+
 vector<long> bfsShortest(const Graph& g, unsigned long src) {
     vector<long> distances(g.n, INF);
     queue<unsigned long> nodesQueue;
@@ -48,10 +122,11 @@ vector<long> bfsShortest(const Graph& g, unsigned long src) {
         unsigned long node = nodesQueue.front();
         nodesQueue.pop();
         
-        for (size_t i = g.adj[node].size(); i-- > 0;) {
-            if (distances[g.adj[node][i].to] == INF) {
-                distances[g.adj[node][i].to] = distances[node] + 1;
-                nodesQueue.push(g.adj[node][i].to);
+        EdgeRange nbrs = g.out(node);
+        for (size_t i = nbrs.size(); i-- > 0;) {
+            if (distances[nbrs[i].to] == INF) {
+                distances[nbrs[i].to] = distances[node] + 1;
+                nodesQueue.push(nbrs[i].to);
             }
         }
     }
@@ -70,7 +145,7 @@ vector<long> zeroOneBfs(const Graph& g, unsigned long src) {
         unsigned long node = dqNodes.front();
         dqNodes.pop_front();
         
-        for (const Edge& edge : g.adj[node]) {
+        for (const Edge& edge : g.out(node)) {
             if (distances[node] + edge.weight < distances[edge.to]) {
                 distances[edge.to] = distances[node] + edge.weight;
                 if (edge.weight == 0) {
@@ -85,62 +160,691 @@ vector<long> zeroOneBfs(const Graph& g, unsigned long src) {
     return distances;
 }
 
+// Dial's algorithm with C + 1 circular buckets for edge weights in [0, C].
+// Buckets are intrusive doubly linked lists threaded through two flat per-vertex
+// arrays, so a vertex sits in at most one bucket and an improved distance moves it
+// instead of leaving a stale copy behind. The scan stops as soon as no vertex is
+// queued, which also covers vertices that are unreachable from src.
 vector<long> weightedBfs(const Graph& g, unsigned long src, int c) {
+    long width = (long)c + 1;
     vector<long> distances(g.n, INF);
-    vector<queue<unsigned long>> buckets(c + 1);
+    vector<int> bucketHead(width, -1);
+    vector<int> nextInBucket(g.n, -1);
+    vector<int> prevInBucket(g.n, -1);
+    long queued = 0;
+    
+    auto link = [&](int v, long b) {
+        prevInBucket[v] = -1;
+        nextInBucket[v] = bucketHead[b];
+        if (bucketHead[b] != -1) prevInBucket[bucketHead[b]] = v;
+        bucketHead[b] = v;
+    };
+    auto unlink = [&](int v, long b) {
+        if (prevInBucket[v] != -1) nextInBucket[prevInBucket[v]] = nextInBucket[v];
+        else bucketHead[b] = nextInBucket[v];
+        if (nextInBucket[v] != -1) prevInBucket[nextInBucket[v]] = prevInBucket[v];
+    };
     
     distances[src] = 0;
-    buckets[0].push(src);
-    
-    long d = 0;
-    long processed = 0;
-    while (processed < (long)g.n) {
-        while (!buckets[d].empty()) {
-            unsigned long node = buckets[d].front();
-            buckets[d].pop();
-            if (distances[node] < d) continue;
-            for (const Edge& edge : g.adj[node]) {
-                if (distances[node] + edge.weight < distances[edge.to]) {
-                    distances[edge.to] = distances[node] + edge.weight;
-                    buckets[distances[edge.to] % (c + 1)].push(edge.to);
+    link(src, 0);
+    queued = 1;
+    
+    for (long d = 0; queued > 0; d++) {
+        long b = d % width;
+        while (bucketHead[b] != -1) {
+            int node = bucketHead[b];
+            unlink(node, b);
+            queued--;
+            for (const Edge& edge : g.out(node)) {
+                long newDist = distances[node] + edge.weight;
+                if (newDist < distances[edge.to]) {
+                    if (distances[edge.to] == INF) {
+                        queued++;
+                    } else {
+                        unlink(edge.to, distances[edge.to] % width);
+                    }
+                    distances[edge.to] = newDist;
+                    link(edge.to, newDist % width);
                 }
             }
-            processed++;
         }
-    d = (d + 1) % (c + 1);
-}
-
+    }
     
     return distances;
 }
 
 bool allWeightsEqual(const Graph& g, long weightVal) {
     for (unsigned long u = 0; u < g.n; ++u) {
-        for (size_t i = 0; i < g.adj[u].size(); ++i) {
-            if (g.adj[u][i].weight != weightVal) return false;
+        for (const Edge& e : g.out(u)) {
+            if (e.weight != weightVal) return false;
         }
     }
     return true;
 }
 
-long maxWeight(const Graph& g) {
+// Default bucket width: the largest weight over the average out-degree, so a
+// bucket holds roughly one hop of a typical vertex and the heavy phase still
+// sees edges. Taking the largest weight itself would leave every edge light.
+long defaultDelta(const Graph& g) {
     long maxVal = 0;
+    long edgeTotal = 0;
     for (unsigned long u = g.n; u-- > 0;) {
-        for (const Edge& e : g.adj[u]) {
+        for (const Edge& e : g.out(u)) {
             maxVal = max(maxVal, (long)e.weight);
+            edgeTotal++;
+        }
+    }
+    if (edgeTotal == 0) return 1;
+    return max(1L, maxVal * g.n / edgeTotal);
+}
+
+// Shared state of a delta-stepping team. Every thread owns its own bucket
+// array; thread 0 gathers the current bucket of all threads into one frontier
+// between phases, and the frontier is then relaxed in dynamically claimed chunks.
+// runBarrier also counts the caller, who uses it to start a run and to wait for
+// its end; the workers themselves sync on barrier between phases.
+struct DeltaState {
+    const Graph* g;
+    long threadCount;
+    long delta;
+    bool quit;
+    pthread_barrier_t runBarrier;
+    vector<atomic<long>> dist;
+    vector<vector<vector<unsigned long>>> localBuckets; // [thread][bucket]
+    vector<vector<unsigned long>> localSettled; // vertices of the current bucket, for the heavy phase
+    vector<unsigned long> frontier;
+    atomic<size_t> nextChunk;
+    long current;
+    bool heavyPhase;
+    bool done;
+    pthread_barrier_t barrier;
+};
+
+struct DeltaThreadData {
+    long threadNum;
+    DeltaState* state;
+};
+
+const size_t DELTA_CHUNK = 64;
+
+// Lower slot to newDist if that is an improvement; true when this call won
+bool atomicRelax(atomic<long>& slot, long newDist) {
+    long cur = slot.load(memory_order_relaxed);
+    while (newDist < cur) {
+        if (slot.compare_exchange_weak(cur, newDist, memory_order_relaxed)) return true;
+    }
+    return false;
+}
+
+// Append the given per-thread lists to the frontier and empty them
+void gatherFrontier(DeltaState* st, vector<vector<unsigned long>*>& lists) {
+    st->frontier.clear();
+    for (vector<unsigned long>* list : lists) {
+        st->frontier.insert(st->frontier.end(), list->begin(), list->end());
+        vector<unsigned long>().swap(*list);
+    }
+}
+
+// Serial step between phases, run by thread 0: keep relaxing light edges of the
+// current bucket until it stays empty, then its heavy edges once, then move on
+// to the smallest non-empty bucket of any thread
+void advanceDelta(DeltaState* st) {
+    vector<vector<unsigned long>*> lists;
+    st->nextChunk.store(0, memory_order_relaxed);
+    
+    if (!st->heavyPhase) {
+        for (long t = 0; t < st->threadCount; t++) {
+            if ((long)st->localBuckets[t].size() > st->current) lists.push_back(&st->localBuckets[t][st->current]);
+        }
+        gatherFrontier(st, lists);
+        if (!st->frontier.empty()) return;
+        
+        lists.clear();
+        for (long t = 0; t < st->threadCount; t++) {
+            lists.push_back(&st->localSettled[t]);
+        }
+        gatherFrontier(st, lists);
+        st->heavyPhase = true;
+        if (!st->frontier.empty()) return;
+    }
+    
+    st->heavyPhase = false;
+    long next = -1;
+    for (long t = 0; t < st->threadCount; t++) {
+        for (long b = st->current + 1; b < (long)st->localBuckets[t].size(); b++) {
+            if (next != -1 && b >= next) break;
+            if (!st->localBuckets[t][b].empty()) {
+                next = b;
+                break;
+            }
+        }
+    }
+    if (next == -1) {
+        st->done = true;
+        return;
+    }
+    st->current = next;
+    lists.clear();
+    for (long t = 0; t < st->threadCount; t++) {
+        if ((long)st->localBuckets[t].size() > next) lists.push_back(&st->localBuckets[t][next]);
+    }
+    gatherFrontier(st, lists);
+}
+
+// One run, from the bucket of the source until every bucket is empty
+void relaxBuckets(DeltaState* st, long threadNum) {
+    const Graph& g = *st->g;
+    vector<vector<unsigned long>>& buckets = st->localBuckets[threadNum];
+    vector<unsigned long>& settled = st->localSettled[threadNum];
+    
+    while (true) {
+        pthread_barrier_wait(&st->barrier);
+        if (threadNum == 0) {
+            advanceDelta(st);
+        }
+        pthread_barrier_wait(&st->barrier);
+        if (st->done) break;
+        
+        bool heavy = st->heavyPhase;
+        while (true) {
+            size_t begin = st->nextChunk.fetch_add(DELTA_CHUNK, memory_order_relaxed);
+            if (begin >= st->frontier.size()) break;
+            size_t end = min(begin + DELTA_CHUNK, st->frontier.size());
+            for (size_t i = begin; i < end; i++) {
+                unsigned long u = st->frontier[i];
+                long du = st->dist[u].load(memory_order_relaxed);
+                if (!heavy) {
+                    if (du / st->delta != st->current) continue; // stale entry
+                    settled.push_back(u);
+                }
+                for (const Edge& edge : g.out(u)) {
+                    if ((edge.weight > st->delta) != heavy) continue;
+                    long newDist = du + edge.weight;
+                    if (atomicRelax(st->dist[edge.to], newDist)) {
+                        size_t b = newDist / st->delta;
+                        if (b >= buckets.size()) buckets.resize(b + 1);
+                        buckets[b].push_back(edge.to);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void* deltaWorker(void* arg) {
+    DeltaThreadData* data = (DeltaThreadData*)arg;
+    DeltaState* st = data->state;
+    
+    while (true) {
+        pthread_barrier_wait(&st->runBarrier);
+        if (st->quit) break;
+        relaxBuckets(st, data->threadNum);
+        pthread_barrier_wait(&st->runBarrier);
+    }
+    
+    return nullptr;
+}
+
+// Delta-stepping (Meyer & Sanders): edges of weight <= delta are light and
+// relaxed repeatedly while the current bucket refills, heavy edges once per
+// bucket. The team is spawned once and then runs every source of a query.
+class DeltaSteppingTeam {
+public:
+    DeltaSteppingTeam(const Graph& g, long threadCount, long delta) : threads(threadCount), threadData(threadCount) {
+        st.g = &g;
+        st.threadCount = threadCount;
+        st.delta = max(1L, delta);
+        st.quit = false;
+        st.dist = vector<atomic<long>>(g.n);
+        st.localBuckets.resize(threadCount);
+        st.localSettled.resize(threadCount);
+        pthread_barrier_init(&st.barrier, nullptr, threadCount);
+        pthread_barrier_init(&st.runBarrier, nullptr, threadCount + 1);
+        for (long i = 0; i < threadCount; i++) {
+            threadData[i].threadNum = i;
+            threadData[i].state = &st;
+            pthread_create(&threads[i], nullptr, deltaWorker, &threadData[i]);
+        }
+    }
+    
+    DeltaSteppingTeam(const DeltaSteppingTeam&) = delete;
+    DeltaSteppingTeam& operator=(const DeltaSteppingTeam&) = delete;
+    
+    ~DeltaSteppingTeam() {
+        st.quit = true;
+        pthread_barrier_wait(&st.runBarrier);
+        for (pthread_t& t : threads) {
+            pthread_join(t, nullptr);
+        }
+        pthread_barrier_destroy(&st.runBarrier);
+        pthread_barrier_destroy(&st.barrier);
+    }
+    
+    // Distances from src; a finished run leaves every bucket empty
+    vector<long> run(unsigned long src) {
+        for (atomic<long>& d : st.dist) {
+            d.store(INF, memory_order_relaxed);
+        }
+        st.current = 0;
+        st.heavyPhase = false;
+        st.done = false;
+        st.dist[src].store(0);
+        if (st.localBuckets[0].empty()) st.localBuckets[0].resize(1);
+        st.localBuckets[0][0].push_back(src);
+        
+        pthread_barrier_wait(&st.runBarrier);
+        pthread_barrier_wait(&st.runBarrier);
+        
+        vector<long> distances(st.g->n);
+        for (int v = 0; v < st.g->n; v++) {
+            distances[v] = st.dist[v].load(memory_order_relaxed);
+        }
+        return distances;
+    }
+    
+private:
+    DeltaState st;
+    vector<pthread_t> threads;
+    vector<DeltaThreadData> threadData;
+};
+
+const size_t MSBFS_WIDTH = 64;
+
+// MS-BFS (Then et al.): up to 64 BFS runs share every adjacency scan. Bit i of
+// seen[v] / visit[v] says whether source i has reached v / has v in its frontier.
+// The vertices with a non-zero visit word are also kept in a frontier list, so a
+// level only touches the frontier and its edges and a batch costs O(n + m).
+// Returns one distance row per source.
+vector<vector<long>> multiSourceBfs(const Graph& g, const vector<unsigned long>& sources) {
+    vector<vector<long>> distances(sources.size(), vector<long>(g.n, INF));
+    vector<uint64_t> seen(g.n, 0), visit(g.n, 0), visitNext(g.n, 0);
+    vector<unsigned long> frontier, next;
+    
+    for (size_t batch = 0; batch < sources.size(); batch += MSBFS_WIDTH) {
+        size_t width = min(MSBFS_WIDTH, sources.size() - batch);
+        fill(seen.begin(), seen.end(), 0);
+        frontier.clear();
+        for (size_t i = 0; i < width; i++) {
+            unsigned long src = sources[batch + i];
+            if (visit[src] == 0) frontier.push_back(src);
+            seen[src] |= 1ULL << i;
+            visit[src] |= 1ULL << i;
+            distances[batch + i][src] = 0;
+        }
+        
+        for (long level = 1; !frontier.empty(); level++) {
+            next.clear();
+            for (unsigned long v : frontier) {
+                for (const Edge& edge : g.out(v)) {
+                    uint64_t newBits = visit[v] & ~seen[edge.to];
+                    if (newBits) {
+                        if (visitNext[edge.to] == 0) next.push_back(edge.to);
+                        visitNext[edge.to] |= newBits;
+                        seen[edge.to] |= newBits;
+                    }
+                }
+            }
+            for (unsigned long v : frontier) {
+                visit[v] = 0;
+            }
+            for (unsigned long v : next) {
+                for (uint64_t bits = visitNext[v]; bits; bits &= bits - 1) {
+                    distances[batch + __builtin_ctzll(bits)][v] = level;
+                }
+            }
+            visit.swap(visitNext);
+            frontier.swap(next);
+        }
+    }
+    
+    return distances;
+}
+
+// Label-correcting Dijkstra over a batch of up to 64 sources. Distances are
+// stored vertex-major (dist[v * width + i]) and dirty[v] marks the sources whose
+// label at v improved since v was last scanned, so one pass over v's edges
+// relaxes all of them. The heap is keyed by the smallest improved label; every
+// dirty label at a popped vertex is at least the popped key, so keys stay
+// monotone and the radix heap applies.
+vector<vector<long>> batchedDijkstra(const Graph& g, const vector<unsigned long>& sources) {
+    vector<vector<long>> distances(sources.size());
+    vector<long> dist;
+    vector<uint64_t> dirty(g.n);
+    
+    for (size_t batch = 0; batch < sources.size(); batch += MSBFS_WIDTH) {
+        size_t width = min(MSBFS_WIDTH, sources.size() - batch);
+        dist.assign((size_t)g.n * width, INF);
+        fill(dirty.begin(), dirty.end(), 0);
+        RadixHeapQueue pqNodes;
+        for (size_t i = 0; i < width; i++) {
+            unsigned long src = sources[batch + i];
+            dist[src * width + i] = 0;
+            dirty[src] |= 1ULL << i;
+            pqNodes.push(0, src);
+        }
+        
+        while (!pqNodes.empty()) {
+            unsigned long node = pqNodes.pop().second;
+            uint64_t mask = dirty[node];
+            if (mask == 0) continue;
+            dirty[node] = 0;
+            
+            const long* from = &dist[node * width];
+            for (const Edge& edge : g.out(node)) {
+                long* to = &dist[(size_t)edge.to * width];
+                uint64_t improved = 0;
+                long best = INF;
+                for (uint64_t bits = mask; bits; bits &= bits - 1) {
+                    int i = __builtin_ctzll(bits);
+                    long newDist = from[i] + edge.weight;
+                    if (newDist < to[i]) {
+                        to[i] = newDist;
+                        improved |= 1ULL << i;
+                        best = min(best, newDist);
+                    }
+                }
+                if (improved) {
+                    dirty[edge.to] |= improved;
+                    pqNodes.push(best, edge.to);
+                }
+            }
+        }
+        
+        for (size_t i = 0; i < width; i++) {
+            distances[batch + i].resize(g.n);
+            for (int v = 0; v < g.n; v++) {
+                distances[batch + i][v] = dist[(size_t)v * width + i];
+            }
+        }
+    }
+    
+    return distances;
+}
+
+// Per-vertex labels for point-to-point queries. A label only counts when its
+// stamp matches the current query, so reset() is O(1) and a query touches only
+// the vertices its searches reach instead of initialising n distances.
+struct QueryLabels {
+    vector<long> dist;
+    vector<uint32_t> stamp;
+    uint32_t epoch;
+    
+    explicit QueryLabels(size_t n) : dist(n), stamp(n, 0), epoch(0) {}
+    
+    void reset() {
+        if (++epoch == 0) {
+            fill(stamp.begin(), stamp.end(), 0);
+            epoch = 1;
+        }
+    }
+    
+    long get(unsigned long v) const { return stamp[v] == epoch ? dist[v] : INF; }
+    
+    void set(unsigned long v, long d) {
+        dist[v] = d;
+        stamp[v] = epoch;
+    }
+};
+
+// Scratch space reused by every query on the same graph
+struct PointQueryState {
+    QueryLabels forward;
+    QueryLabels backward;
+    vector<unsigned long> frontier[2];
+    vector<unsigned long> next;
+    
+    explicit PointQueryState(size_t n) : forward(n), backward(n) {}
+};
+
+// Zero lower bound: A* with it is Dijkstra that stops once t is settled
+struct NoHeuristic {
+    void setTarget(unsigned long) {}
+    long operator()(unsigned long) const { return 0; }
+};
+
+// Stream of the first ALT landmark, see blockStream in graph.h
+const uint64_t ALT_PHASE_LANDMARK = 0xFFFF0101ULL;
+
+// ALT lower bounds (Goldberg and Harrelson) from a few landmarks. For every
+// landmark L the triangle inequality gives d(v,t) >= d(L,t) - d(L,v) and
+// d(v,t) >= d(v,L) - d(t,L); the heuristic is the largest such bound, which is
+// consistent, so A* still settles every vertex once. A landmark that reaches v
+// but not t (or is reached from t but not from v) proves t unreachable from v;
+// the bound is then INF and A* drops v. Landmarks are picked by farthest-point
+// selection starting from a random vertex, drawn from its own stream so that
+// the rand() sequence of query pairs is the same as for the other algorithms.
+class LandmarkHeuristic {
+public:
+    LandmarkHeuristic(const Graph& g, int count, uint64_t seed) : k(0) {
+        if (g.n == 0) return;
+        vector<long> closest(g.n, INF);
+        unsigned long landmark = blockStream(seed, ALT_PHASE_LANDMARK, 0).below(g.n);
+        for (int i = 0; i < count; i++) {
+            vector<long> from = dijkstraPath(g, landmark);
+            vector<long> to = g.directed ? dijkstraReverse(g, landmark) : from;
+            fromLandmark.push_back(from);
+            toLandmark.push_back(to);
+            k++;
+            
+            // Next landmark: the reachable vertex farthest from all chosen ones,
+            // or some vertex none of them reaches
+            long farthest = -1;
+            long unreached = -1;
+            for (unsigned long v = 0; v < (unsigned long)g.n; v++) {
+                closest[v] = min(closest[v], from[v]);
+                if (closest[v] == INF) {
+                    unreached = v;
+                } else if (closest[v] > farthest) {
+                    farthest = closest[v];
+                    landmark = v;
+                }
+            }
+            if (farthest <= 0) {
+                if (unreached < 0) break;
+                landmark = unreached;
+            }
+        }
+        packed.resize((size_t)g.n * k * 2);
+        for (unsigned long v = 0; v < (unsigned long)g.n; v++) {
+            for (int i = 0; i < k; i++) {
+                packed[(v * k + i) * 2] = fromLandmark[i][v];
+                packed[(v * k + i) * 2 + 1] = toLandmark[i][v];
+            }
+        }
+        vector<vector<long>>().swap(fromLandmark);
+        vector<vector<long>>().swap(toLandmark);
+        targetFrom.resize(k);
+        targetTo.resize(k);
+    }
+    
+    int landmarks() const { return k; }
+    
+    void setTarget(unsigned long t) {
+        for (int i = 0; i < k; i++) {
+            targetFrom[i] = packed[(t * k + i) * 2];
+            targetTo[i] = packed[(t * k + i) * 2 + 1];
+        }
+    }
+    
+    long operator()(unsigned long v) const {
+        const long* row = &packed[v * k * 2];
+        long bound = 0;
+        for (int i = 0; i < k; i++) {
+            long fromL = row[2 * i], toL = row[2 * i + 1];
+            if (fromL != INF) {
+                if (targetFrom[i] == INF) return INF;
+                bound = max(bound, targetFrom[i] - fromL);
+            }
+            if (targetTo[i] != INF) {
+                if (toL == INF) return INF;
+                bound = max(bound, toL - targetTo[i]);
+            }
+        }
+        return bound;
+    }
+    
+private:
+    // Distances to src, following edges backwards
+    static vector<long> dijkstraReverse(const Graph& g, unsigned long src) {
+        vector<long> distances(g.n, INF);
+        BinaryHeapQueue pqNodes;
+        distances[src] = 0;
+        pqNodes.push(0, src);
+        while (!pqNodes.empty()) {
+            pair<long, unsigned long> top = pqNodes.pop();
+            if (top.first > distances[top.second]) continue;
+            for (const Edge& edge : g.in(top.second)) {
+                long newDist = top.first + edge.weight;
+                if (newDist < distances[edge.to]) {
+                    distances[edge.to] = newDist;
+                    pqNodes.push(newDist, edge.to);
+                }
+            }
+        }
+        return distances;
+    }
+    
+    int k;
+    vector<vector<long>> fromLandmark, toLandmark;
+    vector<long> packed; // per vertex and landmark: d(L, v), d(v, L)
+    vector<long> targetFrom, targetTo;
+};
+
+// A* from s to t; returns d(s, t) or INF. Heuristic must be consistent and
+// may return INF for vertices that cannot reach t.
+template <class Heuristic>
+long astarQuery(const Graph& g, unsigned long s, unsigned long t, Heuristic& h, PointQueryState& st) {
+    QueryLabels& dist = st.forward;
+    QueryLabels& settled = st.backward; // with a consistent h a vertex is final when first popped
+    dist.reset();
+    settled.reset();
+    h.setTarget(t);
+    BinaryHeapQueue pqNodes;
+    long bound = h(s);
+    if (bound == INF) return INF;
+    dist.set(s, 0);
+    pqNodes.push(bound, s);
+    
+    while (!pqNodes.empty()) {
+        pair<long, unsigned long> top = pqNodes.pop();
+        unsigned long node = top.second;
+        if (settled.get(node) != INF) continue;
+        settled.set(node, 0);
+        long d = dist.get(node);
+        if (node == t) return d;
+        
+        for (const Edge& edge : g.out(node)) {
+            long newDist = d + edge.weight;
+            if (newDist < dist.get(edge.to)) {
+                bound = h(edge.to);
+                if (bound == INF) continue;
+                dist.set(edge.to, newDist);
+                pqNodes.push(newDist + bound, edge.to);
+            }
         }
     }
-    return maxVal;
+    return INF;
+}
+
+// Bidirectional Dijkstra: a forward search from s over out() and a backward one
+// from t over in(), always advancing the side with the smaller queue top. Every
+// relaxed edge that reaches a vertex labelled by the other side updates the best
+// s-t distance found so far, and the searches stop once the two tops together
+// reach it, since no undiscovered path can be shorter.
+long bidirectionalDijkstra(const Graph& g, unsigned long s, unsigned long t, PointQueryState& st) {
+    if (s == t) return 0;
+    QueryLabels* dist[2] = {&st.forward, &st.backward};
+    dist[0]->reset();
+    dist[1]->reset();
+    BinaryHeapQueue pq[2];
+    dist[0]->set(s, 0);
+    dist[1]->set(t, 0);
+    pq[0].push(0, s);
+    pq[1].push(0, t);
+    long best = INF;
+    
+    while (!pq[0].empty() && !pq[1].empty()) {
+        if (pq[0].topKey() + pq[1].topKey() >= best) break;
+        int side = pq[0].topKey() <= pq[1].topKey() ? 0 : 1;
+        pair<long, unsigned long> top = pq[side].pop();
+        unsigned long node = top.second;
+        if (top.first > dist[side]->get(node)) continue;
+        
+        EdgeRange edges = side == 0 ? g.out(node) : g.in(node);
+        for (const Edge& edge : edges) {
+            long newDist = top.first + edge.weight;
+            if (newDist < dist[side]->get(edge.to)) {
+                dist[side]->set(edge.to, newDist);
+                pq[side].push(newDist, edge.to);
+            }
+            long other = dist[1 - side]->get(edge.to);
+            if (other != INF) best = min(best, newDist + other);
+        }
+    }
+    return best;
+}
+
+// Bidirectional BFS for unit weights: expands one whole level at a time on the
+// side whose frontier has fewer edges to scan. After the first level in which
+// the searches meet, the smallest meeting sum is the distance (any shorter path
+// would have met in an earlier level).
+long bidirectionalBfs(const Graph& g, unsigned long s, unsigned long t, PointQueryState& st) {
+    if (s == t) return 0;
+    QueryLabels* dist[2] = {&st.forward, &st.backward};
+    dist[0]->reset();
+    dist[1]->reset();
+    dist[0]->set(s, 0);
+    dist[1]->set(t, 0);
+    st.frontier[0].assign(1, s);
+    st.frontier[1].assign(1, t);
+    long work[2] = {(long)g.out(s).size(), (long)g.in(t).size()};
+    
+    while (!st.frontier[0].empty() && !st.frontier[1].empty()) {
+        int side = work[0] <= work[1] ? 0 : 1;
+        long best = INF;
+        st.next.clear();
+        long nextWork = 0;
+        for (unsigned long node : st.frontier[side]) {
+            long level = dist[side]->get(node) + 1;
+            EdgeRange edges = side == 0 ? g.out(node) : g.in(node);
+            for (const Edge& edge : edges) {
+                if (dist[side]->get(edge.to) != INF) continue;
+                dist[side]->set(edge.to, level);
+                long other = dist[1 - side]->get(edge.to);
+                if (other != INF) best = min(best, level + other);
+                st.next.push_back(edge.to);
+                nextWork += side == 0 ? g.out(edge.to).size() : g.in(edge.to).size();
+            }
+        }
+        if (best != INF) return best;
+        st.frontier[side].swap(st.next);
+        work[side] = nextWork;
+    }
+    return INF;
+}
+
+const long P2P_QUERIES = 1000;
+const int ALT_LANDMARKS = 8;
+const long P2P_VERIFY = 10; // queries checked against a full Dijkstra
+
+long percentile(const vector<long>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t idx = (size_t)ceil(p * sorted.size());
+    return sorted[min(sorted.size(), max((size_t)1, idx)) - 1];
 }
 
 int main(int argc, char* argv[]) {
-    if (argc < 6 || argc > 7) {
-        cout << "Run: " << argv[0] << " <typeGraph> <numNodes> <edgesOrSparsity> <weightType> <seedValue> [algorithm]" << endl;
-        cout << "Types: VARM, VARN" << endl;
+    if (argc < 6 || argc > 9) {
+        cout << "Run: " << argv[0] << " <typeGraph> <numNodes> <edgesOrSparsity> <weightType> <seedValue> [algorithm] [threads] [delta]" << endl;
+        cout << "Types: VARM, VARN, RMAT, GRID2D, GRID3D, GEO, BA, CHAIN, FILE" << endl;
+        cout << "FILE: numNodes is the path of a graph written by graphgen, edgesOrSparsity ignored; weightType must match the file" << endl;
+        cout << "RMAT/GEO: nodes, edges; BA: nodes, edges (edges/nodes links per vertex); GRID2D/GRID3D/CHAIN: nodes, ignored" << endl;
         cout << "VARM: nodes, edges" << endl;
         cout << "VARN: sparsity=1(2n),2(nlogn),3(nsqrt(n)),4(max)" << endl;
         cout << "Weights: unweighted, 01, wbfs_c" << endl;
-        cout << "Algorithm: dijkstra, bfs" << endl;
+        cout << "Algorithm: dijkstra, dijkstra_radix, bfs, delta, batch" << endl;
+        cout << "Point-to-point (random s-t pairs): p2p_dijkstra, bidijkstra, bibfs (unit weights), alt" << endl;
+        cout << "delta: bucket width for delta stepping (default: max edge weight / average degree)" << endl;
         return 0;
     }
     
@@ -149,10 +853,14 @@ int main(int argc, char* argv[]) {
     unsigned long sparsityOrEdges = atoi(argv[3]);
     string weightKind = argv[4];
     unsigned int seedValue = atoi(argv[5]);
-    string algoChoice = (argc == 7) ? argv[6] : "all";
+    string algoChoice = (argc >= 7) ? argv[6] : "all";
+    long threadCount = (argc >= 8) ? atol(argv[7]) : thread::hardware_concurrency();
+    if (threadCount <= 0) threadCount = 1;
     
-    unsigned long edgeCount;
-    if (graphType == "VARM") {
+    unsigned long edgeCount = 0;
+    if (graphType == "FILE") {
+        srand(seedValue);
+    } else if (graphType == "VARM") {
         edgeCount = sparsityOrEdges;
     } else if (graphType == "VARN") {
         if (sparsityOrEdges == 1) {
@@ -167,6 +875,8 @@ int main(int argc, char* argv[]) {
             cout << "Error: bad sparsity" << endl;
             return 0;
         }
+    } else if (Graph::isGraphFamily(graphType)) {
+        edgeCount = sparsityOrEdges;
     } else {
         cout << "Error: bad graph type" << endl;
         return 0;
@@ -174,23 +884,43 @@ int main(int argc, char* argv[]) {
     
     Graph graph(1);
     
-    if (weightKind == "unweighted") {
-        graph = Graph::generateRandomGraph(nodeCount, edgeCount, false, 1, seedValue);
+    bool family = Graph::isGraphFamily(graphType);
+    if (graphType == "FILE") {
+        if (!Graph::loadBinary(argv[2], graph)) {
+            cout << "Error: cannot load graph file " << argv[2] << endl;
+            return 0;
+        }
+        nodeCount = graph.n;
+        edgeCount = graph.m;
+    } else if (weightKind == "unweighted") {
+        graph = family ? Graph::generateFamilyGraph(graphType, nodeCount, edgeCount, false, 1, seedValue, threadCount)
+                       : Graph::generateRandomGraph(nodeCount, edgeCount, false, 1, seedValue, threadCount);
     } else if (weightKind == "01") {
-        graph = Graph::generateRandomGraph01(nodeCount, edgeCount, false, 0.3, seedValue);
+        graph = family ? Graph::generateFamilyGraph01(graphType, nodeCount, edgeCount, false, 0.3, seedValue, threadCount)
+                       : Graph::generateRandomGraph01(nodeCount, edgeCount, false, 0.3, seedValue, threadCount);
     } else if (weightKind.substr(0, 5) == "wbfs_") {
         long maxW = atoi(weightKind.substr(5).c_str());
-        graph = Graph::generateRandomGraph(nodeCount, edgeCount, false, maxW, seedValue);
+        graph = family ? Graph::generateFamilyGraph(graphType, nodeCount, edgeCount, false, maxW, seedValue, threadCount)
+                       : Graph::generateRandomGraph(nodeCount, edgeCount, false, maxW, seedValue, threadCount);
     } else {
         cout << "Error: bad weight type" << endl;
         return 0;
     }
+    if (family) {
+        nodeCount = graph.n;
+        edgeCount = graph.m;
+    }
+    graph.freeze();
+    long delta = (argc == 9) ? atol(argv[8]) : defaultDelta(graph);
     
     long sourceCount = min(10L, (long)nodeCount);
     
     if (algoChoice == "all") {
         long long dijkstraDuration = 0;
+        long long radixDuration = 0;
+        long long deltaDuration = 0;
         long long bfsDuration = 0;
+        DeltaSteppingTeam deltaTeam(graph, threadCount, delta);
         
         for (long i = 0; i < sourceCount; ++i) {
             unsigned long src = rand() % nodeCount;
@@ -200,6 +930,16 @@ int main(int argc, char* argv[]) {
             auto end = chrono::high_resolution_clock::now();
             dijkstraDuration += chrono::duration_cast<chrono::microseconds>(end - start).count();
             
+            start = chrono::high_resolution_clock::now();
+            auto distRadix = dijkstraRadix(graph, src);
+            end = chrono::high_resolution_clock::now();
+            radixDuration += chrono::duration_cast<chrono::microseconds>(end - start).count();
+            
+            start = chrono::high_resolution_clock::now();
+            auto distDelta = deltaTeam.run(src);
+            end = chrono::high_resolution_clock::now();
+            deltaDuration += chrono::duration_cast<chrono::microseconds>(end - start).count();
+            
             start = chrono::high_resolution_clock::now();
             if (weightKind == "unweighted") {
                 auto distBfs = bfsShortest(graph, src);
@@ -214,14 +954,97 @@ int main(int argc, char* argv[]) {
         }
         
         dijkstraDuration /= sourceCount;
+        radixDuration /= sourceCount;
+        deltaDuration /= sourceCount;
         bfsDuration /= sourceCount;
         
         cout << "SHORTEST_PATH," << graphType << "," << nodeCount << "," << edgeCount << ","
              << weightKind << ",DIJKSTRA," << dijkstraDuration << endl;
+        cout << "SHORTEST_PATH," << graphType << "," << nodeCount << "," << edgeCount << ","
+             << weightKind << ",DIJKSTRA_RADIX," << radixDuration << endl;
+        cout << "SHORTEST_PATH," << graphType << "," << nodeCount << "," << edgeCount << ","
+             << weightKind << ",DELTA_STEPPING," << deltaDuration << endl;
         cout << "SHORTEST_PATH," << graphType << "," << nodeCount << "," << edgeCount << ","
              << weightKind << ",BFS_VARIANT," << bfsDuration << endl;
+    } else if (algoChoice == "batch") {
+        vector<unsigned long> sources;
+        for (long i = 0; i < sourceCount; ++i) {
+            sources.push_back(rand() % nodeCount);
+        }
+        
+        auto start = chrono::high_resolution_clock::now();
+        if (weightKind == "unweighted") {
+            auto dist = multiSourceBfs(graph, sources);
+        } else {
+            auto dist = batchedDijkstra(graph, sources);
+        }
+        auto end = chrono::high_resolution_clock::now();
+        long long duration = chrono::duration_cast<chrono::microseconds>(end - start).count() / sourceCount;
+        
+        cout << "SHORTEST_PATH," << graphType << "," << nodeCount << "," << edgeCount << ","
+             << weightKind << ",BATCH," << duration << endl;
+    } else if (algoChoice == "p2p_dijkstra" || algoChoice == "bidijkstra" || algoChoice == "bibfs" || algoChoice == "alt") {
+        string algoName = algoChoice == "p2p_dijkstra" ? "P2P_DIJKSTRA" : algoChoice == "bidijkstra" ? "BIDIJKSTRA"
+                        : algoChoice == "bibfs" ? "BIBFS" : "ALT";
+        if (algoChoice == "bibfs" && !allWeightsEqual(graph, 1)) {
+            cout << "Error: bibfs needs unit weights" << endl;
+            return 1;
+        }
+        
+        PointQueryState state(graph.n);
+        NoHeuristic noBound;
+        unique_ptr<LandmarkHeuristic> landmarks;
+        if (algoChoice == "alt") {
+            auto start = chrono::high_resolution_clock::now();
+            landmarks = make_unique<LandmarkHeuristic>(graph, ALT_LANDMARKS, seedValue);
+            auto end = chrono::high_resolution_clock::now();
+            cout << "SHORTEST_PATH_PREP," << graphType << "," << nodeCount << "," << edgeCount << ","
+                 << weightKind << ",ALT," << chrono::duration_cast<chrono::microseconds>(end - start).count()
+                 << "," << landmarks->landmarks() << endl;
+        }
+        
+        vector<long> times;
+        for (long i = 0; i < P2P_QUERIES; ++i) {
+            unsigned long s = rand() % nodeCount;
+            unsigned long t = rand() % nodeCount;
+            
+            auto start = chrono::high_resolution_clock::now();
+            long dist;
+            if (algoChoice == "p2p_dijkstra") {
+                dist = astarQuery(graph, s, t, noBound, state);
+            } else if (algoChoice == "bidijkstra") {
+                dist = bidirectionalDijkstra(graph, s, t, state);
+            } else if (algoChoice == "bibfs") {
+                dist = bidirectionalBfs(graph, s, t, state);
+            } else {
+                dist = astarQuery(graph, s, t, *landmarks, state);
+            }
+            auto end = chrono::high_resolution_clock::now();
+            long us = chrono::duration_cast<chrono::microseconds>(end - start).count();
+            times.push_back(us);
+            
+            cout << "P2P_QUERY," << graphType << "," << nodeCount << "," << edgeCount << ","
+                 << weightKind << "," << algoName << "," << s << "," << t << ","
+                 << (dist == INF ? -1 : dist) << "," << us << endl;
+            if (i < P2P_VERIFY && dist != dijkstraPath(graph, s)[t]) {
+                cout << "Mismatch: " << algoName << " gives " << dist << " for " << s << " -> " << t << endl;
+            }
+        }
+        
+        // Summary: mean, p50, p90, p99 and max query time in microseconds
+        long long total = 0;
+        for (long us : times) total += us;
+        sort(times.begin(), times.end());
+        cout << "SHORTEST_PATH_P2P," << graphType << "," << nodeCount << "," << edgeCount << ","
+             << weightKind << "," << algoName << "," << total / (long long)times.size() << ","
+             << percentile(times, 0.50) << "," << percentile(times, 0.90) << ","
+             << percentile(times, 0.99) << "," << times.back() << endl;
     } else {
         long long duration = 0;
+        unique_ptr<DeltaSteppingTeam> deltaTeam;
+        if (algoChoice == "delta") {
+            deltaTeam = make_unique<DeltaSteppingTeam>(graph, threadCount, delta);
+        }
         
         for (long i = 0; i < sourceCount; ++i) {
             unsigned long src = rand() % nodeCount;
@@ -229,6 +1052,10 @@ int main(int argc, char* argv[]) {
             
             if (algoChoice == "dijkstra") {
                 auto dist = dijkstraPath(graph, src);
+            } else if (algoChoice == "dijkstra_radix") {
+                auto dist = dijkstraRadix(graph, src);
+            } else if (algoChoice == "delta") {
+                auto dist = deltaTeam->run(src);
             } else if (algoChoice == "bfs") {
                 if (weightKind == "unweighted") {
                     auto dist = bfsShortest(graph, src);
@@ -249,7 +1076,10 @@ int main(int argc, char* argv[]) {
         
         duration /= sourceCount;
         
-        string algoName = (algoChoice == "dijkstra") ? "DIJKSTRA" : "BFS_VARIANT";
+        string algoName = "BFS_VARIANT";
+        if (algoChoice == "dijkstra") algoName = "DIJKSTRA";
+        else if (algoChoice == "dijkstra_radix") algoName = "DIJKSTRA_RADIX";
+        else if (algoChoice == "delta") algoName = "DELTA_STEPPING";
         cout << "SHORTEST_PATH," << graphType << "," << nodeCount << "," << edgeCount << ","
              << weightKind << "," << algoName << "," << duration << endl;
     }
@@ -1,92 +1,111 @@
 #include "graph.h"
+#include "visited.h"
+#include "parallel.h"
 #include <queue>
 #include <vector>
 #include <iostream>
 #include <chrono>
 #include <algorithm>
 #include <cmath>
+#include <atomic>
+#include <pthread.h>
+#include <thread>
 using namespace std;
 
-void dfs_scc(const Graph& g, int u, vector<bool>& visited, vector<int>& component, int comp_id) {
-    visited[u] = true;
+void dfs_scc(const Graph& g, int u, VisitedSet& visited, vector<int>& component, int comp_id, vector<int>& reached) {
+    visited.set(u);
     component[u] = comp_id;
+    reached.push_back(u);
     
-    for (const Edge& e : g.adj[u]) {
+    for (const Edge& e : g.out(u)) {
         if (!visited[e.to]) {
-            dfs_scc(g, e.to, visited, component, comp_id);
+            dfs_scc(g, e.to, visited, component, comp_id, reached);
         }
     }
 }
 
-void dfs_scc_rev(const Graph& g, int u, vector<bool>& visited, vector<int>& component, int comp_id) {
-    visited[u] = true;
+void dfs_scc_rev(const Graph& g, int u, VisitedSet& visited, vector<int>& component, int comp_id, vector<int>& reached) {
+    visited.set(u);
     component[u] = comp_id;
+    reached.push_back(u);
     
-    for (const Edge& e : g.adj_rev[u]) {
+    for (const Edge& e : g.in(u)) {
         if (!visited[e.to]) {
-            dfs_scc_rev(g, e.to, visited, component, comp_id);
+            dfs_scc_rev(g, e.to, visited, component, comp_id, reached);
         }
     }
 }
 
-void bfs_scc(const Graph& g, int start, vector<bool>& visited, vector<int>& component, int comp_id) {
+void bfs_scc(const Graph& g, int start, VisitedSet& visited, vector<int>& component, int comp_id, vector<int>& reached) {
     queue<int> q;
     q.push(start);
-    visited[start] = true;
+    visited.set(start);
     component[start] = comp_id;
+    reached.push_back(start);
     
     while (!q.empty()) {
         int u = q.front();
         q.pop();
         
-        for (const Edge& e : g.adj[u]) {
-            if (!visited[e.to]) {
-                visited[e.to] = true;
+        for (const Edge& e : g.out(u)) {
+            if (!visited.testAndSet(e.to)) {
                 component[e.to] = comp_id;
+                reached.push_back(e.to);
                 q.push(e.to);
             }
         }
     }
 }
 
-void bfs_scc_rev(const Graph& g, int start, vector<bool>& visited, vector<int>& component, int comp_id) {
+void bfs_scc_rev(const Graph& g, int start, VisitedSet& visited, vector<int>& component, int comp_id, vector<int>& reached) {
     queue<int> q;
     q.push(start);
-    visited[start] = true;
+    visited.set(start);
     component[start] = comp_id;
+    reached.push_back(start);
     
     while (!q.empty()) {
         int u = q.front();
         q.pop();
         
-        for (const Edge& e : g.adj_rev[u]) {
-            if (!visited[e.to]) {
-                visited[e.to] = true;
+        for (const Edge& e : g.in(u)) {
+            if (!visited.testAndSet(e.to)) {
                 component[e.to] = comp_id;
+                reached.push_back(e.to);
                 q.push(e.to);
             }
         }
     }
 }
 
+// Only vertices one of the two traversals touched can carry comp_id; those not
+// reached both ways go back to unassigned. Costs O(|reached|), not O(n).
+void keepBothWays(const vector<int>& reached, const VisitedSet& visited_g, const VisitedSet& visited_gr,
+                  vector<int>& component, int comp_id) {
+    for (int j : reached) {
+        if (component[j] == comp_id && !(visited_g[j] && visited_gr[j])) {
+            component[j] = -1;
+        }
+    }
+}
+
 vector<int> algo1(const Graph& g) {
     vector<int> component(g.n, -1);
+    VisitedSet visited_g(g.n);
+    VisitedSet visited_gr(g.n);
+    vector<int> reached;
     int comp_id = 0;
     
     for (int i = 0; i < g.n; i++) {
         if (component[i] == -1) {
-            vector<bool> visited_g(g.n, false);
-            dfs_scc(g, i, visited_g, component, comp_id);
+            reached.clear();
+            visited_g.clear();
+            dfs_scc(g, i, visited_g, component, comp_id, reached);
             
-            vector<bool> visited_gr(g.n, false);
-            dfs_scc_rev(g, i, visited_gr, component, comp_id);
-                
-            for (int j = 0; j < g.n; j++) {
-                if (visited_g[j] && visited_gr[j] && component[j] == comp_id) {
-                } else if (component[j] == comp_id) {
-                    component[j] = -1;
-                }
-            }
+            visited_gr.clear();
+            dfs_scc_rev(g, i, visited_gr, component, comp_id, reached);
+
+            keepBothWays(reached, visited_g, visited_gr, component, comp_id);
             
             comp_id++;
         }
@@ -97,22 +116,21 @@ vector<int> algo1(const Graph& g) {
 
 vector<int> algo2(const Graph& g) {
     vector<int> component(g.n, -1);
+    VisitedSet visited_g(g.n);
+    VisitedSet visited_gr(g.n);
+    vector<int> reached;
     int comp_id = 0;
     
     for (int i = 0; i < g.n; i++) {
         if (component[i] == -1) {
-            vector<bool> visited_g(g.n, false);
-            bfs_scc(g, i, visited_g, component, comp_id);
+            reached.clear();
+            visited_g.clear();
+            bfs_scc(g, i, visited_g, component, comp_id, reached);
             
-            vector<bool> visited_gr(g.n, false);
-            bfs_scc_rev(g, i, visited_gr, component, comp_id);
+            visited_gr.clear();
+            bfs_scc_rev(g, i, visited_gr, component, comp_id, reached);
 
-            for (int j = 0; j < g.n; j++) {
-                if (visited_g[j] && visited_gr[j] && component[j] == comp_id) {
-                } else if (component[j] == comp_id) {
-                    component[j] = -1;
-                }
-            }
+            keepBothWays(reached, visited_g, visited_gr, component, comp_id);
             
             comp_id++;
         }
@@ -121,10 +139,10 @@ vector<int> algo2(const Graph& g) {
     return component;
 }
 
-void dfs_finish_time(const Graph& g, int u, vector<bool>& visited,vector<int>& finish_time, int& time_counter) {
-    visited[u] = true;
+void dfs_finish_time(const Graph& g, int u, VisitedSet& visited,vector<int>& finish_time, int& time_counter) {
+    visited.set(u);
     
-    for (const Edge& e : g.adj[u]) {
+    for (const Edge& e : g.out(u)) {
         if (!visited[e.to]) {
             dfs_finish_time(g, e.to, visited, finish_time, time_counter);
         }
@@ -135,7 +153,7 @@ void dfs_finish_time(const Graph& g, int u, vector<bool>& visited,vector<int>& f
 
 vector<int> algo3(const Graph& g) {
     vector<int> component(g.n, -1);
-    vector<bool> visited(g.n, false);
+    VisitedSet visited(g.n);
     vector<int> finish_time(g.n);
     int time_counter = 0;
     
@@ -151,13 +169,15 @@ vector<int> algo3(const Graph& g) {
     }
     sort(finish_order.rbegin(), finish_order.rend());
     
-    fill(visited.begin(), visited.end(), false);
+    visited.clear();
+    vector<int> reached;
     int comp_id = 0;
     
     for (auto& p : finish_order) {
         int u = p.second;
         if (!visited[u]) {
-            dfs_scc_rev(g, u, visited, component, comp_id);
+            reached.clear();
+            dfs_scc_rev(g, u, visited, component, comp_id, reached);
             comp_id++;
         }
     }
@@ -165,13 +185,505 @@ vector<int> algo3(const Graph& g) {
     return component;
 }
 
+struct SccFrame {
+    int v;
+    int edge; // next out-edge of v to look at
+    bool root;
+};
+
+// Pearce's one-pass SCC (PEA_FIND_SCC2) with an explicit call stack.
+// rindex doubles as the result: live vertices hold their DFS index, finished ones
+// the component number, counted down from n-1 so the two ranges never meet.
+// Edges are scanned in the same order as dfs_finish_time, so renumbering the
+// components in reverse gives exactly the ids algo3 assigns.
+vector<int> algo4(const Graph& g) {
+    vector<int> rindex(g.n, 0);
+    vector<SccFrame> callStack;
+    vector<int> pending; // finished vertices whose component root is still open
+    int index = 1;
+    int c = g.n - 1;
+    
+    for (int i = 0; i < g.n; i++) {
+        if (rindex[i] != 0) continue;
+        
+        rindex[i] = index++;
+        callStack.push_back({i, 0, true});
+        while (!callStack.empty()) {
+            SccFrame& f = callStack.back();
+            EdgeRange nbrs = g.out(f.v);
+            if (f.edge < (int)nbrs.size()) {
+                int w = nbrs[f.edge].to;
+                if (rindex[w] == 0) {
+                    rindex[w] = index++;
+                    callStack.push_back({w, 0, true});
+                    continue;
+                }
+                if (rindex[w] < rindex[f.v]) {
+                    rindex[f.v] = rindex[w];
+                    f.root = false;
+                }
+                f.edge++;
+                continue;
+            }
+            
+            int v = f.v;
+            if (f.root) {
+                index--;
+                while (!pending.empty() && rindex[v] <= rindex[pending.back()]) {
+                    rindex[pending.back()] = c;
+                    pending.pop_back();
+                    index--;
+                }
+                rindex[v] = c--;
+            } else {
+                pending.push_back(v);
+            }
+            callStack.pop_back();
+            
+            if (!callStack.empty()) {
+                SccFrame& parent = callStack.back();
+                if (rindex[v] < rindex[parent.v]) {
+                    rindex[parent.v] = rindex[v];
+                    parent.root = false;
+                }
+                parent.edge++;
+            }
+        }
+    }
+    
+    // Components came out in reverse topological order; number them from the source side
+    for (int v = 0; v < g.n; v++) {
+        rindex[v] -= c + 1;
+    }
+    
+    return rindex;
+}
+
+// A set of still unassigned vertices that all carry the same label; every SCC
+// left in the graph lies entirely inside one such subproblem
+struct FwbwTask {
+    int label;
+    vector<int> vertices;
+};
+
+struct FwbwState {
+    const Graph* g;
+    long threadCount;
+    vector<atomic<int>> component;
+    vector<atomic<int>> label; // -1 once the vertex has its component
+    atomic<int> nextComp;
+    atomic<int> nextLabel;
+    vector<int> inDeg;
+    vector<int> outDeg;
+    
+    vector<FwbwTask> tasks;
+    long busyWorkers;
+    pthread_mutex_t taskMutex;
+    pthread_cond_t taskCond;
+};
+
+const int FWBW_GLOBAL_TRIM_PASSES = 3;
+
+void assignSingleton(FwbwState* st, int v) {
+    st->component[v].store(st->nextComp.fetch_add(1, memory_order_relaxed), memory_order_relaxed);
+    st->label[v].store(-1, memory_order_relaxed);
+}
+
+bool hasLiveNeighbor(FwbwState* st, EdgeRange nbrs, int v, int lbl) {
+    for (const Edge& e : nbrs) {
+        if (e.to != v && st->label[e.to].load(memory_order_relaxed) == lbl) return true;
+    }
+    return false;
+}
+
+// Level-synchronous parallel BFS restricted to vertices labelled lbl. One
+// barrier-synchronised team lives for the whole search, and frontiers below
+// REACH_SERIAL_FRONTIER are expanded by thread 0 alone, so long-diameter inputs
+// like CHAIN or grids pay neither thread spawns nor barriers per thin level.
+struct ReachState {
+    FwbwState* st;
+    int lbl;
+    bool forward;
+    AtomicVisitedSet* seen;
+    vector<int> frontiers[2];
+    vector<vector<int>> localNext;
+    vector<size_t> localOffsets;
+    atomic<size_t> nextChunk;
+    int depth;
+    bool done;
+    pthread_barrier_t barrier;
+};
+
+struct ReachThreadData {
+    long threadNum;
+    ReachState* state;
+};
+
+const size_t REACH_CHUNK = 64;
+const size_t REACH_SERIAL_FRONTIER = 1024;
+
+// Expand levels on the calling thread while the frontier is too thin to share
+void expandSerial(ReachState* rs) {
+    const Graph& g = *rs->st->g;
+    while (true) {
+        const vector<int>& frontier = rs->frontiers[rs->depth & 1];
+        if (frontier.empty() || frontier.size() >= REACH_SERIAL_FRONTIER) break;
+        vector<int>& next = rs->frontiers[(rs->depth + 1) & 1];
+        next.clear();
+        for (int u : frontier) {
+            for (const Edge& e : rs->forward ? g.out(u) : g.in(u)) {
+                if (rs->st->label[e.to].load(memory_order_relaxed) == rs->lbl && !rs->seen->testAndSet(e.to)) {
+                    next.push_back(e.to);
+                }
+            }
+        }
+        rs->depth++;
+    }
+    rs->nextChunk.store(0, memory_order_relaxed);
+    rs->done = rs->frontiers[rs->depth & 1].empty();
+}
+
+// Serial step between levels, run by thread 0: size the next frontier, or
+// gather it here and keep going alone when it is small
+void advanceReach(ReachState* rs) {
+    vector<int>& next = rs->frontiers[(rs->depth + 1) & 1];
+    size_t total = 0;
+    for (long t = 0; t < rs->st->threadCount; t++) {
+        rs->localOffsets[t] = total;
+        total += rs->localNext[t].size();
+    }
+    rs->depth++;
+    if (total >= REACH_SERIAL_FRONTIER) {
+        next.resize(total);
+        rs->nextChunk.store(0, memory_order_relaxed);
+        rs->done = false;
+        return;
+    }
+    next.clear();
+    for (vector<int>& local : rs->localNext) {
+        next.insert(next.end(), local.begin(), local.end());
+        local.clear();
+    }
+    expandSerial(rs);
+}
+
+void* reachWorker(void* arg) {
+    ReachThreadData* data = (ReachThreadData*)arg;
+    ReachState* rs = data->state;
+    const Graph& g = *rs->st->g;
+    vector<int>& local = rs->localNext[data->threadNum];
+    
+    while (true) {
+        const vector<int>& frontier = rs->frontiers[rs->depth & 1];
+        local.clear();
+        while (true) {
+            size_t begin = rs->nextChunk.fetch_add(REACH_CHUNK, memory_order_relaxed);
+            if (begin >= frontier.size()) break;
+            size_t end = min(begin + REACH_CHUNK, frontier.size());
+            for (size_t i = begin; i < end; i++) {
+                for (const Edge& e : rs->forward ? g.out(frontier[i]) : g.in(frontier[i])) {
+                    if (rs->st->label[e.to].load(memory_order_relaxed) == rs->lbl && !rs->seen->testAndSet(e.to)) {
+                        local.push_back(e.to);
+                    }
+                }
+            }
+        }
+        
+        pthread_barrier_wait(&rs->barrier);
+        if (data->threadNum == 0) {
+            advanceReach(rs);
+        }
+        pthread_barrier_wait(&rs->barrier);
+        if (rs->done) break;
+        
+        if (!local.empty()) {
+            vector<int>& next = rs->frontiers[rs->depth & 1];
+            copy(local.begin(), local.end(), next.begin() + rs->localOffsets[data->threadNum]);
+        }
+        pthread_barrier_wait(&rs->barrier);
+    }
+    
+    return nullptr;
+}
+
+void parallelReach(FwbwState* st, int pivot, int lbl, bool forward, AtomicVisitedSet& seen) {
+    long threadCount = st->threadCount;
+    ReachState rs;
+    rs.st = st;
+    rs.lbl = lbl;
+    rs.forward = forward;
+    rs.seen = &seen;
+    rs.frontiers[0].assign(1, pivot);
+    rs.localNext.resize(threadCount);
+    rs.localOffsets.resize(threadCount);
+    rs.depth = 0;
+    seen.testAndSet(pivot);
+    expandSerial(&rs);
+    if (rs.done) return;
+    
+    pthread_barrier_init(&rs.barrier, nullptr, threadCount);
+    vector<pthread_t> threads(threadCount);
+    vector<ReachThreadData> threadData(threadCount);
+    for (long i = 0; i < threadCount; i++) {
+        threadData[i] = {i, &rs};
+        pthread_create(&threads[i], nullptr, reachWorker, &threadData[i]);
+    }
+    for (long i = 0; i < threadCount; i++) {
+        pthread_join(threads[i], nullptr);
+    }
+    pthread_barrier_destroy(&rs.barrier);
+}
+
+// Peel vertices with no live in- or out-edges inside the task, using degree
+// counts restricted to the task's label; each such vertex is its own SCC
+void trimTask(FwbwState* st, FwbwTask& task) {
+    const Graph& g = *st->g;
+    vector<int> peel;
+    for (int v : task.vertices) {
+        st->inDeg[v] = 0;
+        st->outDeg[v] = 0;
+        for (const Edge& e : g.in(v)) {
+            if (e.to != v && st->label[e.to].load(memory_order_relaxed) == task.label) st->inDeg[v]++;
+        }
+        for (const Edge& e : g.out(v)) {
+            if (e.to != v && st->label[e.to].load(memory_order_relaxed) == task.label) st->outDeg[v]++;
+        }
+        if (st->inDeg[v] == 0 || st->outDeg[v] == 0) peel.push_back(v);
+    }
+    
+    while (!peel.empty()) {
+        int v = peel.back();
+        peel.pop_back();
+        if (st->label[v].load(memory_order_relaxed) != task.label) continue;
+        assignSingleton(st, v);
+        for (const Edge& e : g.out(v)) {
+            if (st->label[e.to].load(memory_order_relaxed) == task.label && --st->inDeg[e.to] == 0) peel.push_back(e.to);
+        }
+        for (const Edge& e : g.in(v)) {
+            if (st->label[e.to].load(memory_order_relaxed) == task.label && --st->outDeg[e.to] == 0) peel.push_back(e.to);
+        }
+    }
+    
+    size_t kept = 0;
+    for (int v : task.vertices) {
+        if (st->label[v].load(memory_order_relaxed) == task.label) task.vertices[kept++] = v;
+    }
+    task.vertices.resize(kept);
+}
+
+void pushTask(FwbwState* st, FwbwTask&& task) {
+    pthread_mutex_lock(&st->taskMutex);
+    st->tasks.push_back(move(task));
+    pthread_mutex_unlock(&st->taskMutex);
+    pthread_cond_signal(&st->taskCond);
+}
+
+// Sequential FW-BW step on one subproblem: the SCC of the pivot is F∩B, and
+// F\B, B\F and the rest become three new independent subproblems
+void splitTask(FwbwState* st, FwbwTask& task, VisitedSet& fw, VisitedSet& bw, vector<int>& queueBuf) {
+    const Graph& g = *st->g;
+    int pivot = task.vertices[0];
+    
+    for (int pass = 0; pass < 2; pass++) {
+        VisitedSet& seen = pass == 0 ? fw : bw;
+        seen.clear();
+        seen.set(pivot);
+        queueBuf.assign(1, pivot);
+        for (size_t head = 0; head < queueBuf.size(); head++) {
+            int u = queueBuf[head];
+            for (const Edge& e : pass == 0 ? g.out(u) : g.in(u)) {
+                if (st->label[e.to].load(memory_order_relaxed) == task.label && !seen.testAndSet(e.to)) {
+                    queueBuf.push_back(e.to);
+                }
+            }
+        }
+    }
+    
+    int comp = st->nextComp.fetch_add(1, memory_order_relaxed);
+    FwbwTask parts[3];
+    for (FwbwTask& p : parts) {
+        p.label = st->nextLabel.fetch_add(1, memory_order_relaxed);
+    }
+    for (int v : task.vertices) {
+        if (fw[v] && bw[v]) {
+            st->component[v].store(comp, memory_order_relaxed);
+            st->label[v].store(-1, memory_order_relaxed);
+            continue;
+        }
+        int which = fw[v] ? 0 : (bw[v] ? 1 : 2);
+        st->label[v].store(parts[which].label, memory_order_relaxed);
+        parts[which].vertices.push_back(v);
+    }
+    for (FwbwTask& p : parts) {
+        if (!p.vertices.empty()) pushTask(st, move(p));
+    }
+}
+
+struct FwbwThreadData {
+    long threadNum;
+    FwbwState* state;
+};
+
+void* fwbwWorker(void* arg) {
+    FwbwState* st = ((FwbwThreadData*)arg)->state;
+    VisitedSet fw(st->g->n);
+    VisitedSet bw(st->g->n);
+    vector<int> queueBuf;
+    
+    while (true) {
+        pthread_mutex_lock(&st->taskMutex);
+        while (st->tasks.empty() && st->busyWorkers > 0) {
+            pthread_cond_wait(&st->taskCond, &st->taskMutex);
+        }
+        if (st->tasks.empty()) {
+            pthread_mutex_unlock(&st->taskMutex);
+            pthread_cond_broadcast(&st->taskCond);
+            break;
+        }
+        FwbwTask task = move(st->tasks.back());
+        st->tasks.pop_back();
+        st->busyWorkers++;
+        pthread_mutex_unlock(&st->taskMutex);
+        
+        trimTask(st, task);
+        if (task.vertices.size() == 1) {
+            assignSingleton(st, task.vertices[0]);
+        } else if (!task.vertices.empty()) {
+            splitTask(st, task, fw, bw, queueBuf);
+        }
+        
+        pthread_mutex_lock(&st->taskMutex);
+        st->busyWorkers--;
+        bool finished = st->busyWorkers == 0 && st->tasks.empty();
+        pthread_mutex_unlock(&st->taskMutex);
+        if (finished) pthread_cond_broadcast(&st->taskCond);
+    }
+    
+    return nullptr;
+}
+
+// Parallel forward-backward SCC (Hong et al.): a few parallel trim passes, one
+// data-parallel FW-BW step from a high-degree pivot to peel the giant SCC, then
+// the remaining subproblems are trimmed and split concurrently from a shared
+// work queue. Component ids differ from algo3 but the partition is the same.
+vector<int> algo5(const Graph& g, long threadCount) {
+    FwbwState st;
+    st.g = &g;
+    st.threadCount = threadCount;
+    st.component = vector<atomic<int>>(g.n);
+    st.label = vector<atomic<int>>(g.n);
+    st.nextComp.store(0);
+    st.nextLabel.store(1);
+    st.inDeg.resize(g.n);
+    st.outDeg.resize(g.n);
+    parallelFor(threadCount, g.n, [&](long, long begin, long end) {
+        for (long v = begin; v < end; v++) {
+            st.component[v].store(-1, memory_order_relaxed);
+            st.label[v].store(0, memory_order_relaxed);
+        }
+    });
+    
+    for (int pass = 0; pass < FWBW_GLOBAL_TRIM_PASSES; pass++) {
+        atomic<long> trimmed(0);
+        parallelFor(threadCount, g.n, [&](long, long begin, long end) {
+            long local = 0;
+            for (long v = begin; v < end; v++) {
+                if (st.label[v].load(memory_order_relaxed) != 0) continue;
+                if (!hasLiveNeighbor(&st, g.in(v), v, 0) || !hasLiveNeighbor(&st, g.out(v), v, 0)) {
+                    assignSingleton(&st, v);
+                    local++;
+                }
+            }
+            trimmed.fetch_add(local);
+        });
+        if (trimmed.load() == 0) break;
+    }
+    
+    int pivot = -1;
+    long bestScore = -1;
+    for (int v = 0; v < g.n; v++) {
+        long score = (long)g.in(v).size() * g.out(v).size();
+        if (st.label[v].load(memory_order_relaxed) == 0 && score > bestScore) {
+            bestScore = score;
+            pivot = v;
+        }
+    }
+    
+    if (pivot >= 0) {
+        AtomicVisitedSet fw(g.n);
+        AtomicVisitedSet bw(g.n);
+        parallelReach(&st, pivot, 0, true, fw);
+        parallelReach(&st, pivot, 0, false, bw);
+        
+        int giant = st.nextComp.fetch_add(1);
+        FwbwTask parts[3];
+        for (int i = 0; i < 3; i++) {
+            parts[i].label = st.nextLabel.fetch_add(1);
+        }
+        for (int v = 0; v < g.n; v++) {
+            if (st.label[v].load(memory_order_relaxed) != 0) continue;
+            if (fw[v] && bw[v]) {
+                st.component[v].store(giant, memory_order_relaxed);
+                st.label[v].store(-1, memory_order_relaxed);
+                continue;
+            }
+            int which = fw[v] ? 0 : (bw[v] ? 1 : 2);
+            st.label[v].store(parts[which].label, memory_order_relaxed);
+            parts[which].vertices.push_back(v);
+        }
+        for (FwbwTask& p : parts) {
+            if (!p.vertices.empty()) st.tasks.push_back(move(p));
+        }
+    }
+    
+    st.busyWorkers = 0;
+    pthread_mutex_init(&st.taskMutex, nullptr);
+    pthread_cond_init(&st.taskCond, nullptr);
+    vector<pthread_t> threads(threadCount);
+    vector<FwbwThreadData> threadData(threadCount);
+    for (long i = 0; i < threadCount; i++) {
+        threadData[i] = {i, &st};
+        pthread_create(&threads[i], nullptr, fwbwWorker, &threadData[i]);
+    }
+    for (long i = 0; i < threadCount; i++) {
+        pthread_join(threads[i], nullptr);
+    }
+    pthread_cond_destroy(&st.taskCond);
+    pthread_mutex_destroy(&st.taskMutex);
+    
+    vector<int> component(g.n);
+    for (int v = 0; v < g.n; v++) {
+        component[v] = st.component[v].load(memory_order_relaxed);
+    }
+    return component;
+}
+
+// True when a and b put the same vertices together, whatever the ids
+bool samePartition(const vector<int>& a, const vector<int>& b) {
+    if (a.size() != b.size()) return false;
+    vector<int> aToB(a.size(), -1);
+    vector<int> bToA(b.size(), -1);
+    for (size_t v = 0; v < a.size(); v++) {
+        if (a[v] < 0 || b[v] < 0) return false;
+        if (aToB[a[v]] == -1 && bToA[b[v]] == -1) {
+            aToB[a[v]] = b[v];
+            bToA[b[v]] = a[v];
+        } else if (aToB[a[v]] != b[v] || bToA[b[v]] != a[v]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 int main(int argc, char* argv[]) {
-    if (argc < 5 || argc > 6) {
-        cout << "Usage: " << argv[0] << " <graph_type> <n> <m_or_sparsity> <seed> [algorithm]" << endl;
-        cout << "graph_type: VARM or VARN" << endl;
+    if (argc < 5 || argc > 7) {
+        cout << "Usage: " << argv[0] << " <graph_type> <n> <m_or_sparsity> <seed> [algorithm] [threads]" << endl;
+        cout << "graph_type: VARM, VARN, RMAT, GRID2D, GRID3D, GEO, BA, CHAIN or FILE" << endl;
+        cout << "For FILE: n=path of a directed graph written by graphgen, m ignored" << endl;
+        cout << "For RMAT/GEO: n=nodes, m=edges; BA: m/n links per vertex; GRID2D/GRID3D/CHAIN: m ignored" << endl;
         cout << "For VARM: n=nodes, m=edges" << endl;
         cout << "For VARN: n=nodes, sparsity=1(2n), 2(nlogn), 3(n√n), 4(n(n-1)/2)" << endl;
-        cout << "algorithm (optional): algo1, algo2, algo3" << endl;
+        cout << "algorithm (optional): algo1, algo2, algo3, algo4, algo5 (parallel, uses threads)" << endl;
         return 0;
     }
     
@@ -179,10 +691,14 @@ int main(int argc, char* argv[]) {
     int n = atoi(argv[2]);
     int m_or_sparsity = atoi(argv[3]);
     unsigned seed = atoi(argv[4]);
-    string algorithm = (argc == 6) ? argv[5] : "all";
+    string algorithm = (argc >= 6) ? argv[5] : "all";
+    long threads = (argc == 7) ? atol(argv[6]) : thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
     
-    int m;
-    if (graph_type == "VARM") {
+    int m = 0;
+    if (graph_type == "FILE") {
+        srand(seed);
+    } else if (graph_type == "VARM") {
         m = m_or_sparsity;
     } else if (graph_type == "VARN") {
         switch (m_or_sparsity) {
@@ -192,12 +708,29 @@ int main(int argc, char* argv[]) {
             case 4: m = n * (n - 1) / 2; break;
             default: cout << "Invalid sparsity option" << endl; return 0;
         }
+    } else if (Graph::isGraphFamily(graph_type)) {
+        m = m_or_sparsity;
     } else {
         cout << "Invalid graph type" << endl;
         return 0;
     }
     
-    Graph g = Graph::generateRandomGraph(n, m, true, 1, seed);
+    Graph g(1);
+    if (graph_type == "FILE") {
+        if (!Graph::loadBinary(argv[2], g) || !g.directed) {
+            cout << "Cannot load directed graph file " << argv[2] << endl;
+            return 0;
+        }
+        n = g.n;
+        m = g.m;
+    } else if (Graph::isGraphFamily(graph_type)) {
+        g = Graph::generateFamilyGraph(graph_type, n, m, true, 1, seed, threads);
+        n = g.n;
+        m = g.m;
+    } else {
+        g = Graph::generateRandomGraph(n, m, true, 1, seed, threads);
+    }
+    g.freeze();
     
     if (algorithm == "all") {
         auto start_time = chrono::high_resolution_clock::now();
@@ -215,9 +748,25 @@ int main(int argc, char* argv[]) {
         end_time = chrono::high_resolution_clock::now();
         auto algo3_time = chrono::duration_cast<chrono::microseconds>(end_time - start_time).count();
         
+        start_time = chrono::high_resolution_clock::now();
+        auto comp4 = algo4(g);
+        end_time = chrono::high_resolution_clock::now();
+        auto algo4_time = chrono::duration_cast<chrono::microseconds>(end_time - start_time).count();
+        
+        start_time = chrono::high_resolution_clock::now();
+        auto comp5 = algo5(g, threads);
+        end_time = chrono::high_resolution_clock::now();
+        auto algo5_time = chrono::duration_cast<chrono::microseconds>(end_time - start_time).count();
+        
+        if (!samePartition(comp3, comp5)) {
+            cout << "Mismatch: ALGO5 components differ from ALGO3" << endl;
+        }
+        
         cout << "SCC," << graph_type << "," << n << "," << m << "," << "ALGO1," << algo1_time << endl;
         cout << "SCC," << graph_type << "," << n << "," << m << "," << "ALGO2," << algo2_time << endl;
         cout << "SCC," << graph_type << "," << n << "," << m << "," << "ALGO3," << algo3_time << endl;
+        cout << "SCC," << graph_type << "," << n << "," << m << "," << "ALGO4," << algo4_time << endl;
+        cout << "SCC," << graph_type << "," << n << "," << m << "," << "ALGO5," << algo5_time << endl;
     } else {
         auto start_time = chrono::high_resolution_clock::now();
         
@@ -227,6 +776,10 @@ int main(int argc, char* argv[]) {
             auto comp = algo2(g);
         } else if (algorithm == "algo3") {
             auto comp = algo3(g);
+        } else if (algorithm == "algo4") {
+            auto comp = algo4(g);
+        } else if (algorithm == "algo5") {
+            auto comp = algo5(g, threads);
         } else {
             cout << "Invalid algorithm: " << algorithm << endl;
             return 1;
@@ -239,6 +792,8 @@ int main(int argc, char* argv[]) {
         if (algorithm == "algo1") alg_name = "ALGO1";
         else if (algorithm == "algo2") alg_name = "ALGO2";
         else if (algorithm == "algo3") alg_name = "ALGO3";
+        else if (algorithm == "algo4") alg_name = "ALGO4";
+        else if (algorithm == "algo5") alg_name = "ALGO5";
         
         cout << "SCC," << graph_type << "," << n << "," << m << "," << alg_name << "," << exec_time << endl;
     }
@@ -67,6 +67,26 @@ plot "prob1_varm_mem.dat" using 2:xtic(1) title "VARM", \
      "prob1_varn_mem.dat" using 2:xtic(1) title "VARN"
 EOF
 
+if [ -f $LOG_DIR/prob1_scaling.log ]; then
+  awk -F',' '/GRAPH_TRAVERSAL/ {
+    sum[$7]+=$6/1000; count[$7]++
+  } END {
+    for (t in sum) {
+      print t, sum[t]/count[t]
+    }
+  }' $LOG_DIR/prob1_scaling.log | sort -n > prob1_scaling.dat
+
+  gnuplot -persist <<EOF
+set terminal pngcairo size 900,600
+set output "prob1_scaling.png"
+set title "Parallel BFS Strong Scaling"
+set xlabel "Threads"
+set ylabel "Time (ms)"
+set logscale x 2
+plot "prob1_scaling.dat" using 1:2 with linespoints title "BFS_PARALLEL"
+EOF
+fi
+
 grep "SHORTEST_PATH" $LOG_DIR/prob2.log > p2_time.tmp
 grep "MEMORY" $LOG_DIR/prob2.log > p2_mem.tmp
 
@@ -105,6 +125,28 @@ set format y "%.0f"
 plot "prob2_mem.dat" using 2:xtic(1) title "Algorithms"
 EOF
 
+if [ -f $LOG_DIR/prob2_queues.log ]; then
+  awk -F',' '/SHORTEST_PATH/ {
+    key=$2"_"$5"_"$6; sum[key]+=$7; count[key]++
+  } END {
+    for (k in sum) {
+      print k, sum[k]/count[k]
+    }
+  }' $LOG_DIR/prob2_queues.log | sort > prob2_queues.dat
+
+  gnuplot -persist <<EOF
+set terminal pngcairo size 1100,600
+set output "prob2_queues.png"
+set title "SSSP Variants per Weight Kind"
+set style data histograms
+set style fill solid 1.0 border -1
+set boxwidth 0.6
+set xtics rotate by -30
+set ylabel "Time (us)"
+plot "prob2_queues.dat" using 2:xtic(1) title "SSSP"
+EOF
+fi
+
 grep "SCC" $LOG_DIR/prob3.log > p3_time.tmp
 grep "MEMORY" $LOG_DIR/prob3.log > p3_mem.tmp
 
@@ -0,0 +1,125 @@
+#ifndef VISITED_H
+#define VISITED_H
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+using namespace std;
+
+// Each 64-bit slot packs a 32-bit epoch (high half) and the visited bits of 32
+// vertices (low half). Bits only count when the slot's epoch is the current one,
+// so clear() just bumps the epoch instead of zeroing n bits.
+// Slots are grouped in 64-byte lines so the array starts on a cache line.
+struct alignas(64) VisitedLine {
+    uint64_t slot[8];
+};
+
+struct alignas(64) AtomicVisitedLine {
+    atomic<uint64_t> slot[8];
+};
+
+const int VISITED_SLOT_BITS = 32;
+
+class VisitedSet {
+public:
+    explicit VisitedSet(size_t nodes = 0) { resize(nodes); }
+
+    void resize(size_t nodes) {
+        count = nodes;
+        lines.assign((nodes + 255) / 256, VisitedLine());
+        epoch = 1;
+    }
+
+    // O(1) except once every 2^32 - 1 calls, when the stamps have to be reset
+    void clear() {
+        if (++epoch == 0) {
+            lines.assign(lines.size(), VisitedLine());
+            epoch = 1;
+        }
+    }
+
+    size_t size() const { return count; }
+
+    bool test(size_t v) const {
+        uint64_t s = lines[v >> 8].slot[(v >> 5) & 7];
+        return (s >> VISITED_SLOT_BITS) == epoch && ((s >> (v & 31)) & 1);
+    }
+
+    bool operator[](size_t v) const { return test(v); }
+
+    void set(size_t v) { testAndSet(v); }
+
+    // Marks v and returns whether it was already marked
+    bool testAndSet(size_t v) {
+        uint64_t& s = lines[v >> 8].slot[(v >> 5) & 7];
+        uint64_t bits = ((s >> VISITED_SLOT_BITS) == epoch) ? (uint32_t)s : 0;
+        uint64_t mask = 1ULL << (v & 31);
+        s = ((uint64_t)epoch << VISITED_SLOT_BITS) | bits | mask;
+        return bits & mask;
+    }
+
+private:
+    vector<VisitedLine> lines;
+    size_t count;
+    uint32_t epoch;
+};
+
+// Same layout with lock-free testAndSet for traversals that mark vertices from
+// several threads. clear() and resize() must not run concurrently with marking.
+class AtomicVisitedSet {
+public:
+    explicit AtomicVisitedSet(size_t nodes = 0) { resize(nodes); }
+
+    void resize(size_t nodes) {
+        count = nodes;
+        lines = vector<AtomicVisitedLine>((nodes + 255) / 256);
+        reset();
+    }
+
+    void clear() {
+        if (++epoch == 0) {
+            reset();
+        }
+    }
+
+    size_t size() const { return count; }
+
+    bool test(size_t v) const {
+        uint64_t s = lines[v >> 8].slot[(v >> 5) & 7].load(memory_order_relaxed);
+        return (s >> VISITED_SLOT_BITS) == epoch && ((s >> (v & 31)) & 1);
+    }
+
+    bool operator[](size_t v) const { return test(v); }
+
+    // Exactly one of several racing callers sees false for the same v
+    bool testAndSet(size_t v) {
+        atomic<uint64_t>& slot = lines[v >> 8].slot[(v >> 5) & 7];
+        uint64_t mask = 1ULL << (v & 31);
+        uint64_t stamp = (uint64_t)epoch << VISITED_SLOT_BITS;
+        uint64_t s = slot.load(memory_order_relaxed);
+        while (true) {
+            uint64_t bits = ((s & ~0xFFFFFFFFULL) == stamp) ? (uint32_t)s : 0;
+            if (bits & mask) return true;
+            if (slot.compare_exchange_weak(s, stamp | bits | mask, memory_order_relaxed)) {
+                return false;
+            }
+        }
+    }
+
+private:
+    void reset() {
+        for (AtomicVisitedLine& line : lines) {
+            for (atomic<uint64_t>& s : line.slot) {
+                s.store(0, memory_order_relaxed);
+            }
+        }
+        epoch = 1;
+    }
+
+    vector<AtomicVisitedLine> lines;
+    size_t count;
+    uint32_t epoch;
+};
+
+#endif // VISITED_H